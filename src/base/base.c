@@ -621,15 +621,20 @@ static const char aboutString[] =
 
 static const char syntaxString[] =
     "Syntax:\n"
-    "\tderclou [-h] [-d[<num>]] [-f] [-m<num>] [-s<num>]\n"
+    "\tderclou [-h] [-c<num>] [-d[<num>]] [-f] [-m<num>] [-n[<num>]] [-p] [-r] [-s<num>] [-v]\n"
     "Flags:\n"
+    "\t-c<num>    - picture cache size in KB (0 disables it)\n"
     "\t-d[<num>]  - enable debug output (debug level [1])\n"
     "\t-f         - fullscreen mode\n"
     "\t-g<mode>   - graphics mode (normal,2x,linear2x)\n"
     "\t-h         - show help\n"
     "\t-m<num>    - set music volume to <num> (0-255)\n"
+    "\t-n[<num>]  - headless, print frame hashes (dump every <num>th frame)\n"
+    "\t-p         - build the picture pack and quit\n"
+    "\t-r         - write frame timing to timing.csv on exit (or F12)\n"
     "\t-s<num>    - set sfx volume to <num> (0-255)\n"
-    "\t-t         - trainer\n";
+    "\t-t         - trainer\n"
+    "\t-v         - vsync (if the display refresh suits the frame rate)\n";
 
 
 /**********************************************************/
@@ -650,6 +655,12 @@ static void parseOptions(int argc, char *argv[])
     setup.CDAudioFromWav = false;
     setup.Scale         = 1;
     setup.ScaleOverride = false;
+    setup.CollCacheSize = GFX_COLL_CACHE_DEFAULT_KB;
+    setup.BuildPack     = false;
+    setup.Headless      = false;
+    setup.DumpFrames    = 0;
+    setup.ProfileDump   = false;
+    setup.VSync         = false;
 
     for (i = 1; i < argc; i++) {
         s = argv[i];
@@ -661,6 +672,10 @@ static void parseOptions(int argc, char *argv[])
 	            setup.ScaleOverride = true;
 		        break;
 
+            case 'c':
+                setup.CollCacheSize = min(max(atoi(s+2), 0), GFX_COLL_CACHE_MAX_KB);
+                break;
+
             case 'd':
                 setup.Debug = max(atoi(s+2), 0);
                 break;
@@ -669,6 +684,23 @@ static void parseOptions(int argc, char *argv[])
                 setup.FullScreen = true;
                 break;
 
+            case 'n':
+                setup.Headless = true;
+                setup.DumpFrames = max(atoi(s+2), 0);
+                break;
+
+            case 'p':
+                setup.BuildPack = true;
+                break;
+
+            case 'r':
+                setup.ProfileDump = true;
+                break;
+
+            case 'v':
+                setup.VSync = true;
+                break;
+
             case 's':
                 setup.SfxVolume = clamp(atoi(s+2), 0, SND_MAX_VOLUME);
                 break;
@@ -739,6 +771,9 @@ int main(int argc, char **argv)
         dskSetRootPath(".");
     }
 
+    if (setup.BuildPack)
+        return gfxBuildCollPack() ? 0 : 1;
+
     if ((res = tcInit()))
         tcDo();
 
@@ -99,6 +99,12 @@ struct Setup {
     bool CDAudioFromWav;
     unsigned Scale;
     bool ScaleOverride;
+    unsigned CollCacheSize;     /* in KB, 0 disables the picture cache */
+    bool BuildPack;             /* write the picture pack and quit */
+    bool Headless;              /* no window, frames go to the frame sink */
+    unsigned DumpFrames;        /* headless: dump every n-th frame, 0 = none */
+    bool ProfileDump;           /* write the frame timing on exit */
+    bool VSync;                 /* lock presents to the vertical blank */
 };
 
 extern struct Setup setup;
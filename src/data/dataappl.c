@@ -960,30 +960,10 @@ bool tcCheckTimeClocks(U32 buildId)
 
 /* stellt fest, ob 2 Positionen innerhalb des selben Raumes sind */
 
-static bool tcInsideSameRoom(LIST * roomsList, S16 polX, S16 polY, S16 livX,
-			     S16 livY)
+static bool tcInsideSameRoom(struct LSRoomRaster *rooms, S16 polX, S16 polY,
+			     S16 livX, S16 livY)
 {
-    NODE *node;
-    bool detected = false;
-    LSRoom room;
-
-    for (node = LIST_HEAD(roomsList); NODE_SUCC(node) && detected == 0;
-	 node = NODE_SUCC(node)) {
-	room = OL_DATA(node);
-
-	if ((polX >= room->us_LeftEdge)
-	    && (polX <= room->us_LeftEdge + room->us_Width)
-	    && (polY >= room->us_TopEdge)
-	    && (polY <= room->us_TopEdge + room->us_Height)) {
-	    if ((livX >= room->us_LeftEdge)
-		&& (livX <= room->us_LeftEdge + room->us_Width)
-		&& (livY >= room->us_TopEdge)
-		&& (livY <= room->us_TopEdge + room->us_Height))
-		detected = true;
-	}
-    }
-
-    return detected;
+    return lsInsideSameRoom(rooms, polX, polY, livX, livY);
 }
 
 /* Für jeden(?) Schritt einer für JEDEN Einbrecher aufrufen */
@@ -991,23 +971,41 @@ static bool tcInsideSameRoom(LIST * roomsList, S16 polX, S16 polY, S16 livX,
 /* XPos, YPos = Position des Wächters */
 /* wenn 1 -> Alarm! */
 
-bool tcGuardDetectsGuy(LIST * roomsList, U16 us_XPos, U16 us_YPos,
+bool tcGuardDetectsGuy(struct LSRoomRaster *rooms, U16 us_XPos, U16 us_YPos,
 		       U8 uch_ViewDirection, char *puch_GuardName,
 		       char *puch_LivingName)
 {
-    bool detected = false;
-    U16 livXPos = livGetXPos(puch_LivingName);
-    U16 livYPos = livGetYPos(puch_LivingName);
+    uword living = livGetHandle(puch_LivingName);
 
-    if (livWhereIs(puch_GuardName) == livWhereIs(puch_LivingName))
-	if (livIsPositionInViewDirection
-	    (us_XPos, us_YPos, livXPos, livYPos, uch_ViewDirection))
-	    if (tcInsideSameRoom
-		(roomsList, us_XPos + tcX_HOTSPOT, us_YPos,
-		 livXPos + tcX_HOTSPOT, livYPos))
-		detected = true;
+    return tcGuardDetectsGuys(rooms, us_XPos, us_YPos, uch_ViewDirection,
+			      livGetHandle(puch_GuardName), &living, 1) == 0;
+}
+
+/* tcGuardDetectsGuy for several livings (by handle), the guard and its */
+/* rooms are looked up once - returns the first living detected or -1 */
+
+S32 tcGuardDetectsGuys(struct LSRoomRaster *rooms, U16 us_XPos, U16 us_YPos,
+		       U8 uch_ViewDirection, uword us_Guard,
+		       uword * pus_Livings, U32 ul_Count)
+{
+    U32 guardArea = livHWhereIs(us_Guard);
+    uword guardRooms = lsGetRoomSet(rooms, (S16) (us_XPos + tcX_HOTSPOT), (S16) us_YPos);
+    U32 i;
+
+    for (i = 0; i < ul_Count; i++) {
+	U16 livXPos = livHGetXPos(pus_Livings[i]);
+	U16 livYPos = livHGetYPos(pus_Livings[i]);
+
+	if (livHWhereIs(pus_Livings[i]) == guardArea)
+	    if (livIsPositionInViewDirection
+		(us_XPos, us_YPos, livXPos, livYPos, uch_ViewDirection))
+		if (lsShareRoom(rooms, guardRooms,
+				lsGetRoomSet(rooms, (S16) (livXPos + tcX_HOTSPOT),
+					     (S16) livYPos)))
+		    return (S32) i;
+    }
 
-    return detected;
+    return -1;
 }
 
 /* jedesmal aufrufen, wenn ein Objekt bearbeitet wird */
@@ -1086,7 +1084,7 @@ static S32 tcGetWeightOfNerves(S32 teamMood)
     return (255 - teamMood);
 }
 
-void tcInsertGuard(LIST * list, LIST * roomsList, U16 x, U16 y, U16 width,
+void tcInsertGuard(LIST * list, struct LSRoomRaster *rooms, U16 x, U16 y, U16 width,
 		   U16 height, U32 guardId, U8 livId, U32 areaId)
 {
     char name[TXT_KEY_LENGTH];
@@ -1102,7 +1100,7 @@ void tcInsertGuard(LIST * list, LIST * roomsList, U16 x, U16 y, U16 width,
 	if ((x <= (gx + 16)) && ((x + width) >= gx) && (y <= (gy + 23))
 	    && ((y + height) >= gy))
 	    if (tcInsideSameRoom
-		(roomsList, gx + tcX_HOTSPOT, gy, x + tcX_HOTSPOT, y))
+		(rooms, gx + tcX_HOTSPOT, gy, x + tcX_HOTSPOT, y))
 		dbAddObjectNode(list, guardId,
 				OLF_INCLUDE_NAME | OLF_INSERT_STAR);
 }
@@ -75,9 +75,13 @@ extern S32 tcCalcEscapeTime(void);
 extern bool tcKillTheGuard(U32 guyId, U32 buildingId);
 extern bool tcAlarmByPowerLoss(U32 powerId);
 extern bool tcAlarmByTouch(U32 lsoId);
-extern bool tcGuardDetectsGuy(LIST * roomsList, U16 us_XPos, U16 us_YPos,
+extern bool tcGuardDetectsGuy(struct LSRoomRaster *rooms, U16 us_XPos, U16 us_YPos,
 			      U8 uch_ViewDirection, char *puch_GuardName,
 			      char *puch_LivingName);
+extern S32 tcGuardDetectsGuys(struct LSRoomRaster *rooms, U16 us_XPos,
+			      U16 us_YPos, U8 uch_ViewDirection,
+			      uword us_Guard, uword * pus_Livings,
+			      U32 ul_Count);
 extern S32 tcGetCarStrike(Car car);
 extern S32 tcCalcEscapeOfTeam(void);
 extern U32 tcGuyTellsAll(Person p);
@@ -111,7 +115,7 @@ extern U32 tcGuyUsesTool(U32 persId, Building b, U32 toolId, U32 itemId);
 extern U32 tcGuyUsesToolInPlayer(U32 persId, Building b, U32 toolId, U32 itemId,
 				 U32 neededTime);
 
-extern void tcInsertGuard(LIST * list, LIST * roomsList, U16 x, U16 y,
+extern void tcInsertGuard(LIST * list, struct LSRoomRaster *rooms, U16 x, U16 y,
 			  U16 width, U16 height, U32 guardId, U8 livId,
 			  U32 areaId);
 
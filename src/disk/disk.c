@@ -9,6 +9,12 @@
 #include <ctype.h>
 #include <stdlib.h>
 
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
 #include "error/error.h"
 
 #include "disk/disk.h"
@@ -91,6 +97,54 @@ void *dskLoad(const char *Pathname)
     return NULL;
 }
 
+/*
+ * maps a file read-only into memory, so that the pages are shared with
+ * every other process mapping the same file. Where mmap is not available
+ * the file is loaded instead.
+ */
+void *dskMap(const char *Pathname, size_t *size)
+{
+#ifndef _WIN32
+    void *ptr;
+    int fd;
+
+    DebugMsg(ERR_DEBUG, ERROR_MODULE_DISK, "Mapping :%s", Pathname);
+
+    if (!(*size = dskFileLength(Pathname)))
+        return NULL;
+
+    if ((fd = open(Pathname, O_RDONLY)) == -1) {
+        DebugMsg(ERR_WARNING, ERROR_MODULE_DISK, "Open :%s", Pathname);
+        return NULL;
+    }
+
+    ptr = mmap(NULL, *size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+
+    if (ptr == MAP_FAILED) {
+        DebugMsg(ERR_WARNING, ERROR_MODULE_DISK, "Map :%s", Pathname);
+        return NULL;
+    }
+
+    return ptr;
+#else
+    *size = dskFileLength(Pathname);
+
+    return dskLoad(Pathname);
+#endif
+}
+
+void dskUnmap(void *ptr, size_t size)
+{
+    if (ptr) {
+#ifndef _WIN32
+        munmap(ptr, size);
+#else
+        free(ptr);
+#endif
+    }
+}
+
 void dskSave(char *Pathname, void *src, size_t size)
 {
     FILE *fp;
@@ -180,6 +234,18 @@ size_t dskFileLength(const char *Pathname)
     }
 }
 
+/* time of the last modification, 0 if the file does not exist */
+U64 dskFileTime(const char *Pathname)
+{
+    struct stat status;
+
+    if (stat(Pathname, &status) == -1) {
+        return 0;
+    } else {
+        return (U64) status.st_mtime;
+    }
+}
+
 void dskClose(FILE *fp)
 {
     if (fp) {
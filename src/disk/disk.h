@@ -24,6 +24,8 @@ extern void dskSetRootPath(const char *newRootPath);
 extern char *dskGetRootPath(char *result);
 
 void *dskLoad(const char *Pathname);
+void *dskMap(const char *Pathname, size_t *size);
+void dskUnmap(void *ptr, size_t size);
 void dskSave(char *Pathname, void *src, size_t size);
 bool dskBuildPathName(DiskCheckE check,
 		      const char *Directory, const char *Filename, char *Result);
@@ -48,6 +50,7 @@ void dskRead_S32LE(FILE * fp, S32 * x);
 
 
 size_t dskFileLength(const char *Pathname);
+U64 dskFileTime(const char *Pathname);
 
 FILE *dskOpen(const char *Pathname, const char *Mode);
 
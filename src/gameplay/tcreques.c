@@ -29,6 +29,9 @@ void PrintStatus(char *text)
     gfxSetPens(m_gc, 249, 254, GFX_SAME_PEN);
 
     gfxPrint(m_gc, text, 10, GFX_PRINT_SHADOW | GFX_PRINT_CENTER);
+
+    /* status lines often announce longer work - show them right away */
+    gfxFlush();
 }
 
 U32 ShowTheClouRequester(S32 error_class)
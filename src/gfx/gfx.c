@@ -28,6 +28,12 @@
 
 #include "gfx/gfx.h"
 #include "gfx/gfx.ph"
+#include "gfx/gfxkern.h"
+#include "gfx/gfxcache.h"
+#include "gfx/gfxilbm.h"
+#include "gfx/gfxpack.h"
+#include "gfx/gfxprof.h"
+#include "gfx/gfxsink.h"
 
 struct _GC {
     Rect clip;
@@ -47,12 +53,9 @@ struct _GC {
     Font *font;
 };
 
-void gfxILBMToRAW(const U8 *src, U8 *dst, size_t size);
-
 void gfxRealRefreshArea(U16 x, U16 y, U16 w, U16 h);
 
 SDL_Surface *Screen;
-SDL_Surface *windowSurface;
 
 SDL_Window *sdlWindow;
 SDL_Renderer *sdlRenderer;
@@ -83,8 +86,18 @@ typedef struct FrameClock {
     Uint64 perfFreq;
     Uint64 lastCounter;
     Uint64 targetFrameCounts;
+    Uint64 deadline;            /* end of the current frame */
+    Uint64 sleepMarginNS;       /* spun (not slept) before the deadline */
+    bool vsync;                 /* presents wait for the vertical blank */
+    bool presented;             /* a present happened during this frame */
 } FrameClock;
 
+/* bounds of the adaptive sleep margin */
+#define GFX_PACING_MIN_MARGIN_NS    UINT64_C(250000)
+#define GFX_PACING_MAX_MARGIN_NS    UINT64_C(4000000)
+/* yield instead of busy waiting while more than this is left */
+#define GFX_PACING_YIELD_NS         UINT64_C(200000)
+
 static FrameClock FrameTimer = {
     false,
     1000.0 / 60.0,
@@ -92,7 +105,11 @@ static FrameClock FrameTimer = {
     40.0,
     0,
     0,
-    0
+    0,
+    0,
+    UINT64_C(2000000),
+    false,
+    false
 };
 
 static SDL_Palette *gfxGetScreenPalette(void)
@@ -109,6 +126,26 @@ static SDL_Palette *gfxGetScreenPalette(void)
     return palette;
 }
 
+/*
+ * XRGB8888 value of every palette entry. Kept in sync with the screen
+ * palette so a present converts the 8-bit screen in one pass.
+ */
+static U32 ScreenLUT[256];
+
+static void gfxSetScreenColors(SDL_Palette *pal, const SDL_Color *colors,
+                               int first, int count)
+{
+    int i;
+
+    SDL_SetPaletteColors(pal, colors, first, count);
+
+    for (i = 0; i < count; i++) {
+        ScreenLUT[first + i] = ((U32) colors[i].r << 16) |
+                               ((U32) colors[i].g << 8) |
+                               (U32) colors[i].b;
+    }
+}
+
 static void gfxEnsurePerfFreq(void)
 {
     if (FrameTimer.perfFreq)
@@ -128,6 +165,7 @@ static void gfxInitFrameClock(void)
 
     FrameTimer.deltaMs = FrameTimer.simulationTickMs;
     FrameTimer.lastCounter = SDL_GetPerformanceCounter();
+    FrameTimer.deadline = FrameTimer.lastCounter;
 
     if (FrameTimer.targetFrameCounts == 0)
         gfxSetFrameRate(60);
@@ -351,7 +389,8 @@ void gfxHandleWindowEvent(const SDL_Event *ev)
  * inits & dons
  */
 
-void gfxInit(void)
+/* creates the window, renderer and screen texture */
+static bool gfxInitWindow(void)
 {
     Uint32 flags;
     int sw, sh;
@@ -369,7 +408,7 @@ void gfxInit(void)
     if (!SDL_InitSubSystem(SDL_INIT_VIDEO)) {
         DebugMsg(ERR_ERROR, ERROR_MODULE_GFX,
                  "SDL video initialization failed: %s", SDL_GetError());
-        return;
+        return false;
     }
     gfxInitFrameClock();
 
@@ -389,14 +428,14 @@ void gfxInit(void)
     if (!sdlWindow) {
         DebugMsg(ERR_ERROR, ERROR_MODULE_GFX,
                  "SDL_CreateWindow failed: %s", SDL_GetError());
-        return;
+        return false;
     }
 
     sdlRenderer = SDL_CreateRenderer(sdlWindow, NULL);
     if (!sdlRenderer) {
         DebugMsg(ERR_ERROR, ERROR_MODULE_GFX,
                  "SDL_CreateRenderer failed: %s", SDL_GetError());
-        return;
+        return false;
     }
 
     SDL_ShowWindow(sdlWindow);
@@ -442,14 +481,6 @@ void gfxInit(void)
     SDL_SetWindowAlwaysOnTop(sdlWindow, false);
     SDL_SetWindowKeyboardGrab(sdlWindow, true);
 
-    windowSurface = SDL_CreateSurface(SCREEN_WIDTH, SCREEN_HEIGHT,
-                                      SDL_PIXELFORMAT_XRGB8888);
-    if (!windowSurface) {
-        DebugMsg(ERR_ERROR, ERROR_MODULE_GFX,
-                 "SDL_CreateSurface window failed: %s", SDL_GetError());
-        return;
-    }
-
     sdlTexture = SDL_CreateTexture(sdlRenderer,
                                    SDL_PIXELFORMAT_XRGB8888,
                                    SDL_TEXTUREACCESS_STREAMING,
@@ -457,7 +488,7 @@ void gfxInit(void)
     if (!sdlTexture) {
         DebugMsg(ERR_ERROR, ERROR_MODULE_GFX,
                  "SDL_CreateTexture failed: %s", SDL_GetError());
-        return;
+        return false;
     }
     {
 #if SDL_VERSION_ATLEAST(3, 4, 0)
@@ -471,6 +502,45 @@ void gfxInit(void)
         }
     }
 
+    if (setup.VSync)
+        gfxInitVSync();
+
+    return true;
+}
+
+/*
+ * the dialog bubbles (frames, speak & think arrows and the scroll
+ * arrows) are drawn again on every key press in a dialog
+ */
+static void gfxPinHotColls(void)
+{
+    static const uword hotPicts[] = {
+        SPEAK_BUBBLE, THINK_BUBBLE, 9, 10, 145, 146
+    };
+    unsigned i;
+
+    for (i = 0; i < sizeof(hotPicts) / sizeof(hotPicts[0]); i++) {
+        struct Picture *pict = gfxGetPicture(hotPicts[i]);
+
+        if (pict)
+            gfxPinColl(pict->us_CollId, true);
+    }
+}
+
+void gfxInit(void)
+{
+    gfxKernInit();
+
+    if (setup.Headless) {
+        /* no window at all, frames go to the frame sink */
+        SDL_InitSubSystem(SDL_INIT_EVENTS);
+        gfxInitFrameClock();
+
+        gfxInitSink(setup.DumpFrames);
+    } else if (!gfxInitWindow()) {
+        return;
+    }
+
     Screen = SDL_CreateSurface(SCREEN_WIDTH, SCREEN_HEIGHT,
                                SDL_PIXELFORMAT_INDEX8);
     if (!Screen) {
@@ -478,9 +548,19 @@ void gfxInit(void)
                  "SDL_CreateSurface screen failed: %s", SDL_GetError());
         return;
     }
-    if (!gfxGetScreenPalette()) {
-        DebugMsg(ERR_WARNING, ERROR_MODULE_GFX,
-                 "Unable to allocate screen palette: %s", SDL_GetError());
+    {
+        SDL_Palette *pal = gfxGetScreenPalette();
+
+        if (pal) {
+            SDL_Color colors[256];
+            int n = min(pal->ncolors, 256);
+
+            memcpy(colors, pal->colors, n * sizeof(SDL_Color));
+            gfxSetScreenColors(pal, colors, 0, n);
+        } else {
+            DebugMsg(ERR_WARNING, ERROR_MODULE_GFX,
+                     "Unable to allocate screen palette: %s", SDL_GetError());
+        }
     }
 
     gfxSetGC(NULL);
@@ -536,6 +616,13 @@ void gfxInit(void)
     gfxInitCollList();
     gfxInitPictList();
 
+    gfxInitCollPack();
+
+    gfxInitCollCache((size_t) setup.CollCacheSize * 1024);
+
+    if (setup.CollCacheSize)
+        gfxPinHotColls();
+
     gfxSetVideoMode(GFX_VIDEO_MCGA);	/* after rastports !! */
 }
 
@@ -543,15 +630,35 @@ void gfxDone(void)
 {
     gfxSaveWindowPrefs();
 
+    gfxFinishFade();
+
+    if (setup.Headless)
+        gfxDoneSink();
+
+    if (setup.ProfileDump)
+        gfxProfDump(GFX_PROF_FILE_NAME);
+
+    if (setup.CollCacheSize) {
+        GfxCollCacheStats stats;
+
+        gfxGetCollCacheStats(&stats);
+
+        DebugMsg(ERR_DEBUG, ERROR_MODULE_GFX,
+                 "collection cache: %u hits, %u misses, %u evictions, "
+                 "%u of %u KB used",
+                 stats.hits, stats.misses, stats.evictions,
+                 (unsigned) (stats.used / 1024), (unsigned) (stats.limit / 1024));
+    }
+
+    gfxDoneCollCache();
+
     if (PictureList) {
 	RemoveList(PictureList);
 	PictureList = NULL;
     }
 
-    if (CollectionList) {
-	RemoveList(CollectionList);
-	CollectionList = NULL;
-    }
+    gfxDoneCollList();
+    gfxDoneCollPack();
 
     gfxCloseFont(bubbleFont);
     gfxCloseFont(menuFont);
@@ -577,10 +684,6 @@ void gfxDone(void)
         SDL_DestroySurface(Screen);
         Screen = NULL;
     }
-    if (windowSurface) {
-        SDL_DestroySurface(windowSurface);
-        windowSurface = NULL;
-    }
     if (sdlTexture) {
         SDL_DestroyTexture(sdlTexture);
         sdlTexture = NULL;
@@ -653,7 +756,7 @@ void gfxCorrectUpperRPBitmap(void)
  * lists
  */
 
-static void gfxInitCollList(void)
+void gfxInitCollList(void)
 {
     char pathname[DSK_PATH_MAX];
     LIST *tempList = CreateList();
@@ -676,6 +779,7 @@ static void gfxInitCollList(void)
 
 	coll->puch_Filename = NODE_NAME(coll);
 	coll->prepared = NULL;
+	coll->packed = NULL;
 
 	coll->us_TotalWidth = (uword) txtGetKeyAsULONG(3, NODE_NAME(n));
 	coll->us_TotalHeight = (uword) txtGetKeyAsULONG(4, NODE_NAME(n));
@@ -687,6 +791,14 @@ static void gfxInitCollList(void)
     RemoveList(tempList);
 }
 
+void gfxDoneCollList(void)
+{
+    if (CollectionList) {
+	RemoveList(CollectionList);
+	CollectionList = NULL;
+    }
+}
+
 static void gfxInitPictList(void)
 {
     char pathname[DSK_PATH_MAX];
@@ -820,6 +932,11 @@ static void gfxInitGC(GC *gc, U16 x, U16 y, U16 w, U16 h,
  * gfxCloseFont
  */
 
+/*
+ * The font picture is expanded once into a glyph atlas: every glyph is
+ * stored as w * h bytes (0xff where the glyph is set, 0 elsewhere), plus
+ * the span of set columns of each glyph row.
+ */
 static Font *gfxOpenFont(char *fileName, U16 w, U16 h,
                          unsigned char first, unsigned char last,
                          U16 sw, U16 sh)
@@ -827,10 +944,10 @@ static Font *gfxOpenFont(char *fileName, U16 w, U16 h,
     Font *font;
 
     char path[DSK_PATH_MAX];
-    U8 *lbm;
+    U8 *lbm, *bmp;
 
-    SDL_Surface *bmp;
     U32 size;
+    U16 g, count, perLine;
 
 
     /* create font structure. */
@@ -847,21 +964,45 @@ static Font *gfxOpenFont(char *fileName, U16 w, U16 h,
     lbm = dskLoad(path);
 
 
-    bmp = SDL_CreateSurface(sw, sh, SDL_PIXELFORMAT_INDEX8);
     size = sw * sh;
+    bmp = TCAllocMem(size, true);
 
-    if (SDL_MUSTLOCK(bmp))
-	SDL_LockSurface(bmp);
+    gfxILBMToRAW(lbm, bmp, size);
 
-    gfxILBMToRAW(lbm, bmp->pixels, size);
+    free(lbm);
 
-    if (SDL_MUSTLOCK(bmp))
-	SDL_UnlockSurface(bmp);
+    /* build the atlas */
+    count = last - first + 1;
+    perLine = sw / w;
 
-    free(lbm);
+    font->glyphs = TCAllocMem(count * w * h, true);
+    font->spans  = TCAllocMem(count * h * 2, true);
+
+    for (g = 0; g < count; g++) {
+        U16 sx = (g % perLine) * w;
+        U16 sy = (g / perLine) * h;
+        U16 r, c;
+
+        for (r = 0; r < h && sy + r < sh; r++) {
+            U8 *gp = font->glyphs + (g * h + r) * w;
+            U8 *span = font->spans + (g * h + r) * 2;
+            U16 start = w, end = 0;
+
+            for (c = 0; c < w; c++) {
+                if (bmp[(sy + r) * sw + sx + c]) {
+                    gp[c] = 0xff;
+
+                    start = min(start, c);
+                    end = c + 1;
+                }
+            }
+
+            span[0] = (start < end) ? start : 0;
+            span[1] = end;
+        }
+    }
 
-    SDL_SetSurfaceColorKey(bmp, true, 0);
-    font->bmp = bmp;
+    TCFreeMem(bmp, size);
 
     return font;
 }
@@ -869,7 +1010,10 @@ static Font *gfxOpenFont(char *fileName, U16 w, U16 h,
 void gfxCloseFont(Font *font)
 {
     if (font) {
-        SDL_DestroySurface(font->bmp);
+        U16 count = font->last - font->first + 1;
+
+        TCFreeMem(font->glyphs, count * font->w * font->h);
+        TCFreeMem(font->spans, count * font->h * 2);
 
 	TCFreeMem(font, sizeof(*font));
     }
@@ -947,9 +1091,9 @@ void gfxDraw(GC *gc, U16 x, U16 y)
 	gc->cursorY = y;
 
         if (rx == rx1) {
-            gfxRefreshArea(sx, 1, sy, dy);
+            gfxRefreshArea(sx, sy, 1, dy);
         } else if (ry == ry1) {
-            gfxRefreshArea(sx, dx, sy, 1);
+            gfxRefreshArea(sx, sy, dx, 1);
         } else {
             /* the line is slanted. oops. */
             DebugMsg(ERR_DEBUG, ERROR_MODULE_GFX, "gfxDraw");
@@ -1078,13 +1222,15 @@ void gfxPrepareColl(U16 collId)
 
     if (coll->prepared) {
         gfxScratchFromMem(coll->prepared);
-    } else {
+    } else if (!gfxCollCacheFetch(collId)) {
 	char pathname[DSK_PATH_MAX];
 
 	/* Dateiname erstellen */
 	dskBuildPathName(DISK_CHECK_FILE, PICTURE_DIRECTORY, coll->puch_Filename, pathname);
 
-	gfxLoadILBM(pathname);
+	/* decoded pictures are kept in the collection cache if possible */
+	if (!gfxCollCacheLoad(collId, pathname))
+	    gfxLoadILBM(pathname);
 
 	/*
          * coll->prepared wird nicht mit dem ScratchRP initialisert, da
@@ -1096,14 +1242,20 @@ void gfxPrepareColl(U16 collId)
 }
 
 void gfxLoadILBM(char *fileName)
+{
+    gfxLoadILBMToRP(fileName, &ScratchRP);
+}
+
+/* the MemRastPort must be able to hold a whole screen */
+void gfxLoadILBMToRP(char *fileName, MemRastPort *rp)
 {
     U8 *lbm;
 
     /* Collection laden */
     lbm = dskLoad(fileName);
 
-    gfxSetCMAP(lbm);
-    gfxILBMToRAW(lbm, ScratchRP.pixels, SCREEN_SIZE);
+    gfxSetCMAP(lbm, rp->palette);
+    gfxILBMToRAW(lbm, rp->pixels, SCREEN_SIZE);
     free(lbm);
 }
 
@@ -1134,7 +1286,8 @@ void gfxCollToMem(U16 collId, MemRastPort *rp)
 	struct Collection *oldColl;
 
         if ((oldColl = gfxGetCollection(rp->collId))) {
-	    oldColl->prepared = NULL;
+	    /* packed collections fall back to their copy in the pack */
+	    oldColl->prepared = oldColl->packed;
         }
     }
 
@@ -1158,80 +1311,61 @@ void gfxSetRect(uword us_X, uword us_Width)
     GlobalPrintRect.us_Width = us_Width;
 }
 
+/*
+ * Draws a whole string in the given color, row by row through the glyph
+ * atlas. Each glyph is clipped to the screen and to a clip.w * clip.h
+ * area at its own position.
+ */
 static void
-ScreenBlitChar(GC *gc, SDL_Surface *src, Rect *src_rect,
-               SDL_Surface *dst, Rect *dst_rect, U8 color)
+ScreenBlitString(GC *gc, const Font *font, const char *txt, size_t len,
+                 SDL_Surface *dst, S32 x, S32 y, U8 color)
 {
-    Rectangle srcR, dstR, dstR2, areaR;
-
-    U8 *dp, *sp;
-    U16 h;
-
-    /* clip. */
-    srcR.x = src_rect->x;
-    srcR.y = src_rect->y;
-    srcR.w = src_rect->w;
-    srcR.h = src_rect->h;
+    const U16 w = font->w, h = font->h;
+    S32 rows, r;
 
-    dstR.x = 0;
-    dstR.y = 0;
-    dstR.w = dst->w;
-    dstR.h = dst->h;
-
-    dstR2.x = dst_rect->x + gc->clip.x;
-    dstR2.y = dst_rect->y + gc->clip.y;
-    dstR2.w = gc->clip.w;
-    dstR2.h = gc->clip.h;
-    dstR = Clip(dstR, dstR2);
-
-    if (dstR.w <= 0 || dstR.h <= 0) {
+    if (x >= dst->w || y >= dst->h) {
         return;
     }
 
-    /* blit. */
-    areaR.x = dstR.x;
-    areaR.y = dstR.y;
-    areaR.w = min(dstR.w, srcR.w);
-    areaR.h = min(dstR.h, srcR.h);
+    rows = min(min(h, gc->clip.h), dst->h - y);
 
-    dp = dst->pixels;
-    sp = src->pixels;
+    for (r = 0; r < rows; r++) {
+        U8 *dp = (U8 *) dst->pixels + (y + r) * dst->pitch;
+        S32 gx = x;
+        size_t t;
 
-    dp += dstR.y * dst->w + dstR.x;
-    sp += srcR.y * src->w + srcR.x;
+        for (t = 0; t < len && gx < dst->w; t++, gx += w) {
+            const U8 ch = (U8) txt[t];
+            const U8 *gp, *span;
+            S32 c, end;
 
-    h = areaR.h;
+            if (ch < font->first || ch > font->last) {
+                continue;
+            }
+
+            gp = font->glyphs + ((ch - font->first) * h + r) * w;
+            span = font->spans + ((ch - font->first) * h + r) * 2;
+
+            end = min(min(span[1], gc->clip.w), dst->w - gx);
 
-    while (h--) {
-        U16 x;
-        for (x=0; x<areaR.w; x++) {
-            if (sp[x] != 0) {
-                dp[x] = color;
+            for (c = span[0]; c < end; c++) {
+                dp[gx + c] = (dp[gx + c] & ~gp[c]) | (color & gp[c]);
             }
         }
-        dp += dst->pitch;
-        sp += src->pitch;
     }
 }
 
 void gfxPrintExact(GC *gc, const char *txt, U16 x, U16 y)
 {
     const Font *font = gc->font;
-    const U16 w = font->w,
-              h = font->h,
-              base = font->first;
-    const U16 chars_per_line = SCREEN_WIDTH/w;
-    const U8 fg = gc->foreground;
-    size_t len = strlen(txt), t;
+    size_t len = strlen(txt);
 
     SDL_Rect area;
-    Rect srcR, dstR;
-    SDL_Surface *src, *dst;
 
     area.x = gc->clip.x;
     area.y = gc->clip.y;
-    area.w = min(gc->clip.w, len * w);
-    area.h = min(gc->clip.h, h);
+    area.w = min(gc->clip.w, len * font->w);
+    area.h = min(gc->clip.h, font->h);
 
     area.x += x;
     area.y += y;
@@ -1239,38 +1373,14 @@ void gfxPrintExact(GC *gc, const char *txt, U16 x, U16 y)
     if (gc->mode == GFX_JAM_2)
 	SDL_FillSurfaceRect(Screen, &area, gc->background);
 
-    srcR.w = w;
-    srcR.h = h;
-
-    dstR.x = x;
-    dstR.y = y;
-
-    src = font->bmp;
-    dst = Screen;
-
-    if (SDL_MUSTLOCK(dst))
-        SDL_LockSurface(dst);
-    if (SDL_MUSTLOCK(src))
-        SDL_LockSurface(src);
-
-    for (t=0; t<len; t++) {
-        U16 ch;
-
-	ch  = (U8)txt[t];
-        ch -= base;
-
-	srcR.y = (ch / chars_per_line) * h;
-	srcR.x = (ch % chars_per_line) * w;
-
-        ScreenBlitChar(gc, src, &srcR, dst, &dstR, fg);
+    if (SDL_MUSTLOCK(Screen))
+        SDL_LockSurface(Screen);
 
-        dstR.x += w;
-    }
+    ScreenBlitString(gc, font, txt, len, Screen, area.x, area.y,
+                     gc->foreground);
 
-    if (SDL_MUSTLOCK(src))
-        SDL_UnlockSurface(src);
-    if (SDL_MUSTLOCK(dst))
-        SDL_UnlockSurface(dst);
+    if (SDL_MUSTLOCK(Screen))
+        SDL_UnlockSurface(Screen);
 
     gfxRefreshArea(area.x, area.y, area.w, area.h);
 }
@@ -1387,6 +1497,86 @@ static GC *gfxGetGC(S32 l_DestY)
     return gc;
 }
 
+static Uint64 gfxCountsToNS(Uint64 counts)
+{
+    return (Uint64) ((double) counts * 1e9 / (double) FrameTimer.perfFreq);
+}
+
+/*
+ * Sleeps until shortly before the deadline and spins for the rest. The
+ * margin follows the oversleep we actually observe, so on a coarse
+ * scheduler we spin a bit longer and on a precise one we sleep more.
+ */
+static void gfxWaitUntil(Uint64 deadline)
+{
+    Uint64 now = SDL_GetPerformanceCounter();
+    Uint64 start;
+
+    if (now >= deadline)
+        return;
+
+    start = gfxProfStart();
+
+    if (gfxCountsToNS(deadline - now) > FrameTimer.sleepMarginNS) {
+        Uint64 sleepNS = gfxCountsToNS(deadline - now) - FrameTimer.sleepMarginNS;
+        Uint64 sleptNS, overNS, margin;
+
+        SDL_DelayNS(sleepNS);
+
+        sleptNS = gfxCountsToNS(SDL_GetPerformanceCounter() - now);
+        overNS = (sleptNS > sleepNS) ? sleptNS - sleepNS : 0;
+
+        /* moving average of the oversleep plus 25% headroom */
+        margin = (FrameTimer.sleepMarginNS * 7 + overNS + overNS / 4) / 8;
+        FrameTimer.sleepMarginNS =
+            clamp(margin, GFX_PACING_MIN_MARGIN_NS, GFX_PACING_MAX_MARGIN_NS);
+    }
+
+    while ((now = SDL_GetPerformanceCounter()) < deadline) {
+        if (gfxCountsToNS(deadline - now) > GFX_PACING_YIELD_NS)
+            SDL_DelayNS(0);
+        else
+            SDL_CPUPauseInstruction();
+    }
+
+    gfxProfStop(GFX_PROF_SLEEP, start);
+}
+
+/*
+ * Locks presents to the vertical blank if the display refresh is close
+ * to our frame rate (or a multiple of it), so the presents pace the
+ * frames instead of the timer.
+ */
+static void gfxInitVSync(void)
+{
+    const SDL_DisplayMode *mode;
+    double fps = 1000.0 / FrameTimer.targetFrameMs;
+    int interval;
+
+    mode = SDL_GetCurrentDisplayMode(SDL_GetDisplayForWindow(sdlWindow));
+    if (!mode || mode->refresh_rate <= 0.0f) {
+        DebugMsg(ERR_WARNING, ERROR_MODULE_GFX, "vsync: unknown refresh rate");
+        return;
+    }
+
+    interval = max((int) (mode->refresh_rate / fps + 0.5), 1);
+
+    if (SDL_fabs(mode->refresh_rate / interval - fps) > fps * 0.05) {
+        DebugMsg(ERR_WARNING, ERROR_MODULE_GFX,
+                 "vsync: %.2f Hz does not match the frame rate", mode->refresh_rate);
+        return;
+    }
+
+    if (!SDL_SetRenderVSync(sdlRenderer, interval)) {
+        DebugMsg(ERR_WARNING, ERROR_MODULE_GFX,
+                 "SDL_SetRenderVSync failed: %s", SDL_GetError());
+        return;
+    }
+
+    gfxSetFrameRate((U32) (mode->refresh_rate / interval + 0.5));
+    FrameTimer.vsync = true;
+}
+
 void gfxWaitTOF(void)
 {
     Uint64 now;
@@ -1395,27 +1585,43 @@ void gfxWaitTOF(void)
 
     gfxInitFrameClock();
 
-    now = SDL_GetPerformanceCounter();
-    elapsedCounts = now - FrameTimer.lastCounter;
+    gfxFadeStep();
 
-    if (elapsedCounts < FrameTimer.targetFrameCounts) {
-        double remainingMs =
-            (double) (FrameTimer.targetFrameCounts - elapsedCounts) * 1000.0 /
-            (double) FrameTimer.perfFreq;
-        Uint32 delayMs = 0;
+    /* headless runs as fast as possible on a virtual clock */
+    if (setup.Headless) {
+        gfxFlush();
 
-        if (remainingMs > 1.0)
-            delayMs = (Uint32) remainingMs;
-        else if (remainingMs > 0.0)
-            delayMs = 1;
+        FrameTimer.deltaMs = FrameTimer.targetFrameMs;
+        gfxProfFrame();
+        return;
+    }
+
+    /* the one present of this frame - with vsync it waits for the blank */
+    if (FrameTimer.vsync)
+        gfxFlush();
+
+    now = SDL_GetPerformanceCounter();
+
+    if (FrameTimer.vsync && FrameTimer.presented) {
+        /* the present already waited for the vertical blank */
+        FrameTimer.deadline = now;
+    } else {
+        /* frames end on a fixed grid, unless we are a whole frame late */
+        FrameTimer.deadline += FrameTimer.targetFrameCounts;
 
-        if (delayMs)
-            SDL_Delay(delayMs);
+        if (FrameTimer.deadline + FrameTimer.targetFrameCounts < now)
+            FrameTimer.deadline = now;
 
+        gfxWaitUntil(FrameTimer.deadline);
         now = SDL_GetPerformanceCounter();
-        elapsedCounts = now - FrameTimer.lastCounter;
+
+        /* present right at the deadline, so frames arrive on the grid */
+        gfxFlush();
     }
 
+    FrameTimer.presented = false;
+    elapsedCounts = now - FrameTimer.lastCounter;
+
     elapsedMs = (double) elapsedCounts * 1000.0 /
         (double) FrameTimer.perfFreq;
 
@@ -1424,16 +1630,24 @@ void gfxWaitTOF(void)
 
     FrameTimer.deltaMs = elapsedMs;
     FrameTimer.lastCounter = now;
+
+    gfxProfFrame();
 }
 
 void gfxWaitTOR(void)
 {
-    SDL_Delay(20);
+    gfxFlush();
+
+    if (!setup.Headless)
+        SDL_Delay(20);
 }
 
 void gfxWaitTOS(void)
 {
-    SDL_Delay(250);
+    gfxFlush();
+
+    if (!setup.Headless)
+        SDL_Delay(250);
 }
 
 void gfxClearArea(GC *gc)
@@ -1469,7 +1683,8 @@ void gfxSetRGB(GC *gc, U8 color, U8 r, U8 g, U8 b)
     if (!pal)
         return;
 
-    SDL_SetPaletteColors(pal, colors, color, 1);
+    gfxFinishFade();
+    gfxSetScreenColors(pal, colors, color, 1);
 
     gfxRealRefreshArea(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT);
 }
@@ -1484,6 +1699,8 @@ void gfxGetPaletteFromReg(U8 *palette)
 {
     SDL_Palette *pal = gfxGetScreenPalette();
 
+    gfxFinishFade();
+
     if (pal) {
 	SDL_Color *colors;
 	int ncolors, i;
@@ -1500,104 +1717,197 @@ void gfxGetPaletteFromReg(U8 *palette)
     }
 }
 
-void gfxChangeColors(GC *gc, U32 delay, U32 mode, U8 *palette)
+/*
+ * palette fades
+ *
+ * A fade is precomputed into a table with one row of colours per step
+ * and then advanced one step per frame by gfxWaitTOF, so it no longer
+ * blocks input, sound and the animator. gfxChangeColors is the blocking
+ * variant that runs the same table to completion.
+ */
+
+typedef struct {
+    bool active;
+
+    U16 first;                  /* first colour register of the fade */
+    U16 count;                  /* number of registers */
+
+    U16 steps;
+    U16 current;
+
+    SDL_Color *table;           /* steps * count colours */
+} PaletteFade;
+
+static PaletteFade Fade = { false, 0, 0, 0, 0, NULL };
+
+static void gfxFadeColor(SDL_Color *c, const U8 *rgb, S32 fakt, S32 s)
+{
+    c->r = ((S32)rgb[0] * (fakt * s)) / 128;
+    c->g = 16 + (((S32)rgb[1] - 16) * (fakt * s)) / 128;
+    c->b = 12 + (((S32)rgb[2] - 12) * (fakt * s)) / 128;
+    c->a = SDL_ALPHA_OPAQUE;
+}
+
+static void gfxFadeRow(SDL_Color *c, const U8 *cols, U16 st, U16 en,
+                       S32 fakt, S32 s)
+{
+    U16 t;
+
+    for (t=st; t<=en; t++)
+        gfxFadeColor(c++, &cols[t*3], fakt, s);
+}
+
+static void gfxFadeRelease(void)
+{
+    if (Fade.table) {
+        TCFreeMem(Fade.table, Fade.steps * Fade.count * sizeof(SDL_Color));
+        Fade.table = NULL;
+    }
+
+    Fade.active = false;
+}
+
+static void gfxFadeApply(U16 step)
+{
+    SDL_Palette *pal = gfxGetScreenPalette();
+
+    if (pal) {
+        gfxSetScreenColors(pal, &Fade.table[step * Fade.count],
+                           Fade.first, Fade.count);
+    }
+
+    /* the faded colours may be used anywhere on the screen */
+    gfxMarkDirty(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT);
+}
+
+bool gfxFadeActive(void)
+{
+    return Fade.active;
+}
+
+/* advances a running fade by one step, returns false once it is done */
+bool gfxFadeStep(void)
+{
+    if (!Fade.active)
+        return false;
+
+    gfxFadeApply(Fade.current++);
+
+    if (Fade.current >= Fade.steps)
+        gfxFadeRelease();
+
+    return Fade.active;
+}
+
+/* jumps to the final palette of a running fade */
+void gfxFinishFade(void)
+{
+    if (Fade.active) {
+        gfxFadeApply(Fade.steps - 1);
+        gfxFadeRelease();
+    }
+}
+
+void gfxStartFade(GC *gc, U32 delay, U32 mode, U8 *palette)
 	/* l_Delay is min 1 */
 {
     U16 t, st, en;
-    SDL_Color colors[256];
     U8 cols[GFX_PALETTE_SIZE];
-    Rect area;
     S32 time, fakt, s;
-    SDL_Palette *pal = gfxGetScreenPalette();
+    SDL_Color *c;
 
-    if (!pal)
+    gfxFinishFade();
+
+    if (!gfxGetScreenPalette())
         return;
 
     if (gc) {
 	st = gc->colorStart;
 	en = gc->End;
-
-        area = gc->clip;
     } else {
 	st = GlobalColorRange.uch_Start;
 	en = GlobalColorRange.uch_End;
-
-        area.x = 0;
-        area.y = 0;
-        area.w = SCREEN_WIDTH;
-        area.h = SCREEN_HEIGHT;
     }
 
     delay = max(delay, 1);	/* delay must not be zero! */
 
     time = delay;
+    fakt = 128/time;
+
+    Fade.first = st;
+    Fade.count = en - st + 1;
 
     switch (mode) {
     case GFX_FADE_OUT:
-	
         gfxGetPaletteFromReg(cols);
 
-        fakt=128/time;
+        /* from the current colours down to black */
+        Fade.steps = time + 1;
+        break;
 
-        for (s=time; s>=0; s--) {
-            gfxRealRefreshArea(area.x, area.y, area.w, area.h);
-            gfxWaitTOR();
+    case GFX_BLEND_UP:
+        memcpy(cols, palette, GFX_PALETTE_SIZE);
 
-            for (t=st; t<=en; t++) {
-                colors[t].r = ((S32)cols[t*3] * (fakt * s)) / 128;
-                colors[t].g = 16 + (((S32)cols[t*3+1] - 16) * (fakt * s)) / 128;
-                colors[t].b = 12 + (((S32)cols[t*3+2] - 12) * (fakt * s)) / 128;
-            }
-            SDL_SetPaletteColors(pal, &colors[st], st, en - st + 1);
-        }
+        /* black, up from dark and finally the exact colours */
+        Fade.steps = time + 3;
+        break;
 
-	for (t=st; t<=en; t++) {
-	    colors[t].r = 0;
-	    colors[t].g = 0;
-	    colors[t].b = 0;
-        }
-    SDL_SetPaletteColors(pal, &colors[st], st, en - st + 1);
-	break;
+    default:
+        return;
+    }
 
-    case GFX_BLEND_UP:
-        for (t=0; t<GFX_PALETTE_SIZE; t++) {
-            cols[t] = palette[t];
-        }
+    Fade.table = TCAllocMem(Fade.steps * Fade.count * sizeof(SDL_Color), true);
+    if (!Fade.table)
+        return;
 
-        fakt=128/time;
+    c = Fade.table;
 
-	for (t=st; t<=en; t++) {
-	    colors[t].r = 0;
-	    colors[t].g = 0;
-	    colors[t].b = 0;
+    if (mode == GFX_FADE_OUT) {
+        for (s=time; s>0; s--) {
+            gfxFadeRow(c, cols, st, en, fakt, s);
+            c += Fade.count;
         }
-	SDL_SetPaletteColors(pal, &colors[st], st, en - st + 1);
 
-        for (s=0; s<=time; s++) {
-            gfxRealRefreshArea(area.x, area.y, area.w, area.h);
-            gfxWaitTOR();
+        for (t=st; t<=en; t++, c++)
+            c->a = SDL_ALPHA_OPAQUE;
+    } else {
+        for (t=st; t<=en; t++, c++)
+            c->a = SDL_ALPHA_OPAQUE;
 
-            for (t=st; t<=en; t++) {
-                colors[t].r = ((S32)cols[t*3] * (fakt * s)) / 128;
-                colors[t].g = 16 + (((S32)cols[t*3+1] - 16) * (fakt * s)) / 128;
-                colors[t].b = 12 + (((S32)cols[t*3+2] - 12) * (fakt * s)) / 128;
-            }
-            SDL_SetPaletteColors(pal, &colors[st], st, en - st + 1);
+        for (s=0; s<=time; s++) {
+            gfxFadeRow(c, cols, st, en, fakt, s);
+            c += Fade.count;
         }
 
-        gfxRealRefreshArea(area.x, area.y, area.w, area.h);
-        gfxWaitTOR();
-
-	for (t=st; t<=en; t++) {
-	    colors[t].r = palette[t*3+0];
-	    colors[t].g = palette[t*3+1];
-	    colors[t].b = palette[t*3+2];
+        for (t=st; t<=en; t++, c++) {
+            c->r = cols[t*3+0];
+            c->g = cols[t*3+1];
+            c->b = cols[t*3+2];
+            c->a = SDL_ALPHA_OPAQUE;
         }
-    SDL_SetPaletteColors(pal, &colors[st], st, en - st + 1);
-	break;
     }
 
-    gfxRealRefreshArea(area.x, area.y, area.w, area.h);
+    Fade.current = 0;
+    Fade.active = true;
+
+    /* a blend starts from black right away */
+    if (mode == GFX_BLEND_UP)
+        gfxFadeStep();
+}
+
+void gfxChangeColors(GC *gc, U32 delay, U32 mode, U8 *palette)
+	/* l_Delay is min 1 */
+{
+    gfxStartFade(gc, delay, mode, palette);
+
+    while (Fade.active) {
+        gfxRealRefreshArea(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT);
+        gfxWaitTOR();
+
+        gfxFadeStep();
+    }
+
+    gfxRealRefreshArea(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT);
 }
 
 
@@ -1661,7 +1971,8 @@ void gfxShow(uword us_PictId, U32 ul_Mode, S32 l_Delay, S32 l_XPos, S32 l_YPos)
     if (l_Delay && (ul_Mode & GFX_BLEND_UP)) {
 	gfxSetColorRange(coll->uch_ColorRangeStart,
 	                 coll->uch_ColorRangeEnd);
-	gfxChangeColors(NULL, l_Delay, GFX_BLEND_UP, ScratchRP.palette);
+	/* blends up in the background while the scene carries on */
+	gfxStartFade(NULL, l_Delay, GFX_BLEND_UP, ScratchRP.palette);
     }
     gfxScreenThaw(gc, destX, destY, pict->us_Width, pict->us_Height);
 
@@ -1686,132 +1997,22 @@ S32 gfxGetILBMSize(struct Collection *coll)
     return size;
 }
 
-static void gfxSetCMAP(const Uint8 *src)
-{
-    /* look for CMAP chunk */
-    while (memcmp(src, "CMAP", 4) != 0)
-	src++;
-
-    src += 4;			/* skip CMAP chunk */
-    src += 4;			/* skip size of CMAP chunk */
-
-    memcpy(ScratchRP.palette, src, GFX_PALETTE_SIZE);
-}
-
-static void MakeMCGA(U16 b, U8 *pic, uword PlSt, S16 c)
-{
-    U16 bit;
-    S16 i;
-
-    bit = 0x80;
-    for (i=0; i<8; i++) {
-        if ((b & bit) && (c > i)) {
-          pic[i] |= PlSt;
-        }
-        bit >>= 1;
-    }
-}
-
-static U16 MemRead_U16BE(const U8 *p)
-{
-    return ((U16) p[1] | ((U16) p[0] << 8));
-}
-
-void gfxILBMToRAW(const U8 *src, U8 *dst, size_t size)
-{
-    U16 bpp = 0, w = 0, h = 0;
-    const U8 *sp;
-    U8 *pic, *pic1;
-    int s, t, b, x;
-    uword a, y;
-    uword flag;
-
-    sp = src;
-    pic = dst;
-
-    sp += 8;
+/*
+ * The intro animations are streamed: each FORM (the first picture, then
+ * one per delta frame) is read into a small ring of buffers when it is
+ * needed, so only a few frames are in memory instead of the whole file.
+ */
+#define GFX_ANIM_RING           2
+#define GFX_ANIM_MAX_CHUNK      (256 * 1024)
 
-    if (memcmp(sp, "ILBM", 4) != 0) {
-	return;
-    }
+struct AnimStream {
+    FILE *fp;
 
-    sp += 12;
-
-    w = MemRead_U16BE(sp);
-    sp += 2;
-    h = MemRead_U16BE(sp);
-    sp += 6;
-    bpp = *sp;
-    sp += 2;
-    flag = *sp;
-
-    h = min(h, 192);
-
-    while (memcmp(sp, "BODY", 4) != 0) {
-	sp++;
-    }
-
-    sp += 8;
-
-    memset(pic, 0, size);
-
-    if (flag) {
-	pic1 = pic;
-	for (t=0; t<h; t++) {
-	    for (s=0; s<bpp; s++) {
-		pic = pic1;	/* Anfang der aktuellen Zeile */
-		b = ((w + 15) & 0xfff0);
-		do {
-		    a = *sp;	/* Kommando (wiederholen oder übernehmen */
-		    sp++;	/* nächstes Zeichen */
-		    if (a > 128) {	/* Zeichen wiederholen */
-
-			a = 257 - a;
-
-			y = *sp;
-			sp++;
-			for (x = 1; x <= a; x++) {
-			    MakeMCGA(y, pic, (1 << s), b);
-			    pic += 8;
-			    b -= 8;
-			}
-		    } else {	/* Zeichen übernehmen */
-
-			for (x = 0; x <= a; x++) {
-			    y = *sp;
-			    sp++;
-			    MakeMCGA(y, pic, (1 << s), b);
-			    pic += 8;
-			    b -= 8;
-			}
-		    }
-		}
-		while (b > 0);
-	    }
-	    pic1 += SCREEN_WIDTH;
-	}
-    } else {
-	pic1 = pic;
-	for (t=0; t<h; t++) {
-	    for (s=0; s<bpp; s++) {
-		pic = pic1;	/* Anfang der aktuellen Zeile */
-		b = ((w + 15) & 0xfff0);
-		do {
-		    y = *sp;
-		    sp++;
-		    MakeMCGA(y, pic, (1 << s), b);
-		    pic += 8;
-		    b -= 8;
-		}
-		while (b > 0);
-	    }
-	    pic1 += SCREEN_WIDTH;
-	}
-    }
-}
+    U8 *buf[GFX_ANIM_RING];
+    size_t bufSize[GFX_ANIM_RING];
 
-size_t XMSOffset = 0;
-U8 *XMSHandle;
+    unsigned next;              /* slot the next FORM is read into */
+};
 
 
 static const char *names[5] = {
@@ -1876,112 +2077,127 @@ int CDFrames[MAX_TRACKS * 6] = {
     4, 153, 0, 7, 0, 0
 };
 
-static U32 Amg2Pc(U32 s)
+static U32 MemRead_U32BE(const U8 *p)
 {
-    return ((s & 255) << 24) +
-	(((s >> 8) & 255) << 16) +
-	(((s >> 16) & 255) << 8) + (((s >> 24) & 255));
+    return ((U32) p[3] | ((U32) p[2] << 8) | ((U32) p[1] << 16) | ((U32) p[0] << 24));
 }
 
+static void gfxAnimOpen(struct AnimStream *as, FILE *fp)
+{
+    memset(as, 0, sizeof(*as));
+    as->fp = fp;
+}
 
-static void orbyte(U8 *ptr, U8 data, U8 dmask)
+static void gfxAnimClose(struct AnimStream *as)
 {
-  U8 dmaskoff = ~dmask; 
+    unsigned i;
 
-  if (0x80 & data) *ptr++ |= dmask; else *ptr++ &= dmaskoff; 
-  if (0x40 & data) *ptr++ |= dmask; else *ptr++ &= dmaskoff; 
-  if (0x20 & data) *ptr++ |= dmask; else *ptr++ &= dmaskoff; 
-  if (0x10 & data) *ptr++ |= dmask; else *ptr++ &= dmaskoff; 
-  if (0x08 & data) *ptr++ |= dmask; else *ptr++ &= dmaskoff; 
-  if (0x04 & data) *ptr++ |= dmask; else *ptr++ &= dmaskoff; 
-  if (0x02 & data) *ptr++ |= dmask; else *ptr++ &= dmaskoff; 
-  if (0x01 & data) *ptr   |= dmask; else *ptr   &= dmaskoff; 
-}
+    for (i = 0; i < GFX_ANIM_RING; i++)
+        free(as->buf[i]);
 
+    dskClose(as->fp);
+    memset(as, 0, sizeof(*as));
+}
 
-static void ProcessAnimation(U8 *dp, U8 *sp)
+/* reads the next FORM (including its header), NULL at the end of the file */
+static const U8 *gfxAnimReadForm(struct AnimStream *as)
 {
-    U32 size, rsize, *lp;
-    U8 *me, *me1, *me2, *st;
-    U32 offs[8];
-    U8 plane, planeMask;
-    int i, j, col;
+    unsigned slot = as->next;
+    U8 head[8];
+    size_t size;
+
+    if (fread(head, 1, sizeof(head), as->fp) != sizeof(head))
+	return NULL;
 
-    /* skip header */
-    XMSOffset += 4;
-    /* get size */
-    memcpy(&size, XMSHandle+XMSOffset, 4);
-    XMSOffset += 4;
+    if ((size = MemRead_U32BE(&head[4])) > GFX_ANIM_MAX_CHUNK)
+	return NULL;
 
-    rsize = Amg2Pc(size);
+    size += sizeof(head);
 
-    me = dp;
+    if (as->bufSize[slot] < size) {
+        U8 *buf;
 
-    sp = XMSHandle+XMSOffset;
-    XMSOffset += rsize;
+        if (!(buf = realloc(as->buf[slot], size)))
+	    return NULL;
 
-    while (memcmp(sp, "DLTA", 4) != 0) {
-	sp++;
+        as->buf[slot] = buf;
+        as->bufSize[slot] = size;
     }
 
-    sp += 8;
-    lp = (U32 *)sp;
-    st = sp;			/* start of DLTA block */
+    memcpy(as->buf[slot], head, sizeof(head));
 
-    for (i=0; i<8; i++)
-	offs[i] = Amg2Pc(lp[i]);
+    if (fread(as->buf[slot] + sizeof(head), 1, size - sizeof(head), as->fp)
+        != size - sizeof(head))
+	return NULL;
 
-    me2 = me;
+    as->next = (slot + 1) % GFX_ANIM_RING;
+    return as->buf[slot];
+}
 
-    for (plane = 0, planeMask = 1; plane < 8; plane++, planeMask <<= 1) {
-	if (offs[plane] != 0) {
-	    sp = st + offs[plane];
-	    me1 = me2;
+/* sets (or clears) the plane bit of 8 pixels in one go */
+static void gfxAnimPutByte(U8 *dp, unsigned row, unsigned col,
+                           U64 keep, U64 bits)
+{
+    if (row < SCREEN_HEIGHT) {
+        U8 *p = dp + row * SCREEN_WIDTH + col * 8;
+        U64 v;
 
-	    for (col=0; col<40; col++) {
-                U8 op_cnt;
+        memcpy(&v, p, 8);
+        v = (v & keep) | bits;
+        memcpy(p, &v, 8);
+    }
+}
 
-		me = me1;
-		op_cnt = *sp++;
 
-		for (i=0; i<op_cnt; i++) {
-                    U8 op;
+/* applies the DLTA (vertical byte delta) of one animation FORM to dp */
+static void ProcessAnimation(U8 *dp, const U8 *form)
+{
+    const U8 *sp, *st, *end;
+    unsigned plane, col;
+
+    end = form + 8 + MemRead_U32BE(form + 4);
+
+    for (sp = form + 8; sp + 4 <= end && memcmp(sp, "DLTA", 4) != 0; sp++)
+	;
+
+    if (sp + 8 + 8 * 4 > end)
+	return;
 
-		    op = *sp++;
+    st = sp + 8;		/* start of DLTA block */
 
-		    if (op == 0) {
-                        /* same op */
-                        U8 cnt;
-                        U8 val;
+    for (plane = 0; plane < 8; plane++) {
+	const U64 keep = ~(UINT64_C(0x0101010101010101) << plane);
+	U32 offs = MemRead_U32BE(st + plane * 4);
 
-			cnt = *sp++;
-			val = *sp++;
+	if (!offs)
+	    continue;
 
-			for (j=0; j<cnt; j++) {
-                            orbyte(me, val, planeMask);
-			    me += SCREEN_WIDTH;
-			}
-		    } else {
-			if ((op & 0x80)) {
-                            /* uniq op */
-                            U8 cnt;
+	sp = st + offs;
 
-			    cnt = op & 0x7f;
-			    for (j=0; j<cnt; j++) {
-                                U8 val;
-                            
-                                val = *sp++;
-                                orbyte(me, val, planeMask);
-				me += SCREEN_WIDTH;
-			    }
-                        } else {
-                            /* skip op */
-			    me += (SCREEN_WIDTH * op);
-			}
-		    }
+	for (col = 0; col < 40; col++) {
+	    unsigned row = 0;
+	    U8 op_cnt = *sp++;
+	    int i, j;
 
+	    for (i = 0; i < op_cnt; i++) {
+		U8 op = *sp++;
+
+		if (op == 0) {
+		    /* same op */
+		    U8 cnt = *sp++;
+		    U64 bits = gfxPlanarSpread[*sp++] << plane;
+
+		    for (j = 0; j < cnt; j++, row++)
+			gfxAnimPutByte(dp, row, col, keep, bits);
+		} else if (op & 0x80) {
+		    /* uniq op */
+		    for (j = 0; j < (op & 0x7f); j++, row++)
+			gfxAnimPutByte(dp, row, col, keep,
+				       gfxPlanarSpread[*sp++] << plane);
+		} else {
+		    /* skip op */
+		    row += op;
 		}
-		me1 += 8;	/* next column */
 	    }
 	}
     }
@@ -1989,17 +2205,13 @@ static void ProcessAnimation(U8 *dp, U8 *sp)
 
 void ShowIntro(void)
 {
-    U8 *cp;
-    char head[4];
+    const U8 *cp;
     int t, s, anims;
-    size_t size, rsize;
     U8 colorTABLE[GFX_PALETTE_SIZE];
     bool endi = false;
     GC ScreenGC;
     MemRastPort A, B;
 
-    XMSHandle = malloc(818*1024);
-
     /******************************** Init Gfx ********************************/
     gfxInitMemRastPort(&A, SCREEN_WIDTH, SCREEN_HEIGHT);
     gfxInitMemRastPort(&B, SCREEN_WIDTH, SCREEN_HEIGHT);
@@ -2031,35 +2243,23 @@ void ShowIntro(void)
         fp = dskOpen(pathName, "rb");
 
 	if (fp) {
-            XMSOffset = 0;
-
-	    fread(&head[0], 1, 4, fp);
-	    fread(&size, 1, 4, fp);
-	    rsize = Amg2Pc(size);
+            struct AnimStream as;
+            U8 head[12];
 
-            dskRead(fp, XMSHandle, rsize);
-	    dskClose(fp);
+            gfxAnimOpen(&as, fp);
 
-            /* skip header */
-	    XMSOffset += 4;
-            
-            cp = XMSHandle+XMSOffset;
-            
-            /* skip header */
-	    XMSOffset += 4;
-            /* get size */
-            memcpy(&size, XMSHandle+XMSOffset, 4);
-	    XMSOffset += 4;
-
-	    rsize = Amg2Pc(size);
-
-	    XMSOffset += rsize;
+            /* skip FORM header and ANIM type, then the first picture */
+            if (fread(head, 1, sizeof(head), fp) != sizeof(head)
+                || !(cp = gfxAnimReadForm(&as))) {
+                gfxAnimClose(&as);
+                continue;
+            }
 
             gfxChangeColors(NULL, 20, GFX_BLEND_UP, colorTABLE);
             gfxClearArea(NULL);
 
             /* copy from file to A & B */
-            gfxSetCMAP(cp);
+            gfxSetCMAP(cp, ScratchRP.palette);
             gfxILBMToRAW(cp, ScratchRP.pixels, SCREEN_SIZE);
             gfxScratchToMem(&A);
             gfxScratchToMem(&B);
@@ -2098,6 +2298,8 @@ void ShowIntro(void)
 
                 gfxScreenThaw(&ScreenGC, 0, 0, SCREEN_WIDTH, SCREEN_HEIGHT);
 
+                /* read the next delta while we would be waiting anyway */
+                cp = gfxAnimReadForm(&as);
 
             {
             /* Bias animation pacing closer to modern 60 Hz timing without dropping the legacy flavour */
@@ -2117,10 +2319,12 @@ void ShowIntro(void)
             }
 
 
-                if (showA) {
-                    ProcessAnimation(B.pixels, cp);
-                } else {
-                    ProcessAnimation(A.pixels, cp);
+                if (cp) {
+                    if (showA) {
+                        ProcessAnimation(B.pixels, cp);
+                    } else {
+                        ProcessAnimation(A.pixels, cp);
+                    }
                 }
 
                 for (s=0; s<MaxAnm; s++) {
@@ -2182,6 +2386,7 @@ void ShowIntro(void)
 	    }
 
 endit:
+            gfxAnimClose(&as);
             gfxChangeColors(NULL, 1, GFX_FADE_OUT, colorTABLE);
 
 	    if (endi) {
@@ -2205,8 +2410,6 @@ endit2:
 
     gfxDoneMemRastPort(&A);
     gfxDoneMemRastPort(&B);
-
-    free(XMSHandle);
 }
 
 void gfxInitMemRastPort(MemRastPort *rp, U16 width, U16 height)
@@ -2226,6 +2429,66 @@ void gfxDoneMemRastPort(MemRastPort *rp)
     rp->pixels = NULL;
 }
 
+/*
+ * Finds the runs of opaque pixels in every row of rp, so that a masked
+ * blit from rp can copy them as a whole and skip the transparent gaps.
+ * The pixels of rp must not change while the spans are in use.
+ */
+void gfxInitSpans(Spans *spans, const MemRastPort *rp)
+{
+    const U8 *sp;
+    U32 count = 0;
+    U16 x, y;
+
+    for (y = 0, sp = rp->pixels; y < rp->h; y++, sp += rp->w) {
+        for (x = 0; x < rp->w; x++) {
+            if (sp[x] && (x == 0 || !sp[x - 1]))
+                count++;
+        }
+    }
+
+    spans->h = rp->h;
+    spans->count = count;
+    spans->rows = TCAllocMem((rp->h + 1) * sizeof(*spans->rows), false);
+    spans->runs = TCAllocMem(max(count, 1) * 2 * sizeof(*spans->runs), false);
+
+    count = 0;
+
+    for (y = 0, sp = rp->pixels; y < rp->h; y++, sp += rp->w) {
+        spans->rows[y] = count;
+
+        for (x = 0; x < rp->w; ) {
+            U16 start;
+
+            for (; x < rp->w && !sp[x]; x++);
+
+            if (x == rp->w)
+                break;
+
+            for (start = x; x < rp->w && sp[x]; x++);
+
+            spans->runs[count * 2] = start;
+            spans->runs[count * 2 + 1] = x - start;
+            count++;
+        }
+    }
+
+    spans->rows[rp->h] = count;
+}
+
+void gfxDoneSpans(Spans *spans)
+{
+    if (spans->rows) {
+        TCFreeMem(spans->rows, (spans->h + 1) * sizeof(*spans->rows));
+        TCFreeMem(spans->runs, max(spans->count, 1) * 2 * sizeof(*spans->runs));
+    }
+
+    spans->rows = NULL;
+    spans->runs = NULL;
+    spans->h = 0;
+    spans->count = 0;
+}
+
 void gfxScratchFromMem(MemRastPort *src)
 {
     if (src) {
@@ -2246,12 +2509,20 @@ void gfxScratchToMem(MemRastPort *dst)
 void gfxBlit(GC *gc, MemRastPort *src, U16 sx, U16 sy, U16 dx, U16 dy,
              U16 w, U16 h, bool has_mask)
 {
-    Rectangle srcR, srcR2, dstR, dstR2, areaR;
-    SDL_Surface *dst;
-    U8 *dp, *sp;
-    U16 x, y;
+    gfxBlitROp(gc, src, sx, sy, dx, dy, w, h,
+               has_mask ? GFX_ROP_OVERLAY : GFX_ROP_BLIT);
+}
+
+/*
+ * clips a blit from src to the gc, srcR is where the blit starts in src
+ * and areaR the part of the screen it covers
+ */
+static bool gfxClipBlit(GC *gc, MemRastPort *src, U16 sx, U16 sy,
+                        U16 dx, U16 dy, U16 w, U16 h,
+                        Rectangle *srcOut, Rectangle *areaOut)
+{
+    Rectangle srcR, srcR2, dstR, dstR2;
 
-    /* clip. */
     srcR.x = 0;
     srcR.y = 0;
     srcR.w = src->w;
@@ -2264,7 +2535,7 @@ void gfxBlit(GC *gc, MemRastPort *src, U16 sx, U16 sy, U16 dx, U16 dy,
     srcR = Clip(srcR, srcR2);
 
     if (srcR.w <= 0 || srcR.h <= 0)
-        return;
+        return false;
 
     dstR.x = gc->clip.x;
     dstR.y = gc->clip.y;
@@ -2278,60 +2549,216 @@ void gfxBlit(GC *gc, MemRastPort *src, U16 sx, U16 sy, U16 dx, U16 dy,
     dstR = Clip(dstR, dstR2);
 
     if (dstR.w <= 0 || dstR.h <= 0)
+        return false;
+
+    *srcOut = srcR;
+
+    areaOut->x = dstR.x;
+    areaOut->y = dstR.y;
+    areaOut->w = min(dstR.w, srcR.w);
+    areaOut->h = min(dstR.h, srcR.h);
+
+    return true;
+}
+
+void gfxBlitROp(GC *gc, MemRastPort *src, U16 sx, U16 sy, U16 dx, U16 dy,
+                U16 w, U16 h, ROpE op)
+{
+    GfxRopRowFunc rop;
+    Rectangle srcR, areaR;
+    SDL_Surface *dst;
+    U8 *dp, *sp;
+    U16 y;
+    Uint64 start;
+
+    /* clip. */
+    if (!gfxClipBlit(gc, src, sx, sy, dx, dy, w, h, &srcR, &areaR))
         return;
 
     /* blit. */
-    areaR.x = dstR.x;
-    areaR.y = dstR.y;
-    areaR.w = min(dstR.w, srcR.w);
-    areaR.h = min(dstR.h, srcR.h);
-
     dst = Screen;
 
     dp = dst->pixels;
     sp = src->pixels;
 
-    dp += dstR.y * SCREEN_WIDTH + dstR.x;
+    dp += areaR.y * SCREEN_WIDTH + areaR.x;
     sp += srcR.y * src->w + srcR.x;
 
     w = areaR.w;
     h = areaR.h;
 
+    start = gfxProfStart();
+
     if (SDL_MUSTLOCK(dst))
 	SDL_LockSurface(dst);
 
-    if (has_mask) {
-	for (y=0; y<h; y++) {
-	    for (x=0; x<w; x++) {
-		if (sp[x] != 0) {
-		    dp[x] = sp[x];
-		}
-	    }
-	    dp += SCREEN_WIDTH;
-	    sp += src->w;
-	}
-    } else {
-	for (y=0; y<h; y++) {
-	    memcpy(dp, sp, w);
-	    dp += SCREEN_WIDTH;
-	    sp += src->w;
-	}
+    rop = gfxRopRow[op];
+
+    for (y=0; y<h; y++) {
+	rop(dp, sp, w);
+	dp += SCREEN_WIDTH;
+	sp += src->w;
+    }
+
+    if (SDL_MUSTLOCK(dst))
+	SDL_UnlockSurface(dst);
+
+    gfxProfStop(GFX_PROF_BLIT, start);
+
+    gfxRefreshArea(areaR.x, areaR.y, areaR.w, areaR.h);
+}
+
+/*
+ * masked blit that only copies the opaque runs of src (spans must have
+ * been built from src), gives the same result as GFX_ROP_OVERLAY
+ */
+void gfxBlitSpans(GC *gc, MemRastPort *src, const Spans *spans,
+                  U16 sx, U16 sy, U16 dx, U16 dy, U16 w, U16 h)
+{
+    Rectangle srcR, areaR;
+    SDL_Surface *dst;
+    U8 *dp;
+    const U8 *sp;
+    int x0, x1;
+    U16 y;
+    Uint64 start;
+
+    if (!gfxClipBlit(gc, src, sx, sy, dx, dy, w, h, &srcR, &areaR))
+        return;
+
+    dst = Screen;
+
+    dp = (U8 *) dst->pixels + areaR.y * SCREEN_WIDTH + areaR.x;
+    sp = src->pixels + srcR.y * src->w;
+
+    x0 = srcR.x;
+    x1 = srcR.x + areaR.w;
+
+    start = gfxProfStart();
+
+    if (SDL_MUSTLOCK(dst))
+	SDL_LockSurface(dst);
+
+    for (y=0; y<areaR.h; y++) {
+        const U16 *run = spans->runs + spans->rows[srcR.y + y] * 2;
+        const U16 *end = spans->runs + spans->rows[srcR.y + y + 1] * 2;
+
+        for (; run < end && run[0] < x1; run += 2) {
+            int a = max(run[0], x0);
+            int b = min(run[0] + run[1], x1);
+
+            if (a < b)
+                memcpy(dp + (a - x0), sp + a, b - a);
+        }
+
+	dp += SCREEN_WIDTH;
+	sp += src->w;
     }
 
     if (SDL_MUSTLOCK(dst))
 	SDL_UnlockSurface(dst);
 
+    gfxProfStop(GFX_PROF_BLIT, start);
+
     gfxRefreshArea(areaR.x, areaR.y, areaR.w, areaR.h);
 }
 
 static int screen_freeze_count = 0;
 
-/* ZZZ */
-void gfxRealRefreshArea(U16 x, U16 y, U16 w, U16 h)
+/*
+ * dirty rectangles
+ *
+ * All areas handed to gfxRefreshArea are collected in ScreenDirty and
+ * merged while they are added, so that a present only has to convert and
+ * upload the parts of the screen that really changed.
+ */
+
+#define GFX_DIRTY_MAX_RECTS     16
+
+typedef struct {
+    int count;
+    Rectangle rect[GFX_DIRTY_MAX_RECTS];
+} DirtyRegion;
+
+static DirtyRegion ScreenDirty = { 0 };
+
+static int gfxRectArea(Rectangle r)
+{
+    return r.w * r.h;
+}
+
+static Rectangle gfxRectUnion(Rectangle A, Rectangle B)
+{
+    Rectangle C;
+
+    C.x = min(A.x, B.x);
+    C.y = min(A.y, B.y);
+    C.w = max(A.x + A.w, B.x + B.w) - C.x;
+    C.h = max(A.y + A.h, B.y + B.h) - C.y;
+
+    return C;
+}
+
+/* true if joining both rectangles costs (almost) no extra pixels */
+static bool gfxRectShouldMerge(Rectangle A, Rectangle B)
+{
+    int joined = gfxRectArea(gfxRectUnion(A, B));
+
+    /* touching or overlapping rectangles are always merged */
+    if (A.x <= B.x + B.w && B.x <= A.x + A.w &&
+        A.y <= B.y + B.h && B.y <= A.y + A.h)
+        return true;
+
+    return joined <= gfxRectArea(A) + gfxRectArea(B) + SCREEN_WIDTH;
+}
+
+static void gfxAddDirtyRect(Rectangle r)
+{
+    DirtyRegion *dr = &ScreenDirty;
+    int i;
+
+    if (r.w <= 0 || r.h <= 0)
+        return;
+
+    /* merge with every rectangle we touch - this may cascade */
+    i = 0;
+    while (i < dr->count) {
+        if (gfxRectShouldMerge(dr->rect[i], r)) {
+            r = gfxRectUnion(dr->rect[i], r);
+            dr->rect[i] = dr->rect[--dr->count];
+            i = 0;
+        } else {
+            i++;
+        }
+    }
+
+    if (dr->count == GFX_DIRTY_MAX_RECTS) {
+        /* no room left: grow the rectangle that grows least */
+        int best = 0, bestCost = INT32_MAX;
+
+        for (i = 0; i < dr->count; i++) {
+            int cost = gfxRectArea(gfxRectUnion(dr->rect[i], r)) -
+                gfxRectArea(dr->rect[i]);
+
+            if (cost < bestCost) {
+                bestCost = cost;
+                best = i;
+            }
+        }
+
+        r = gfxRectUnion(dr->rect[best], r);
+        dr->rect[best] = dr->rect[--dr->count];
+
+        gfxAddDirtyRect(r);
+        return;
+    }
+
+    dr->rect[dr->count++] = r;
+}
+
+static void gfxMarkDirty(U16 x, U16 y, U16 w, U16 h)
 {
     Rectangle areaR, areaR2;
-    void *pixels;
-    int pitch;
 
     areaR.x = 0;
     areaR.y = 0;
@@ -2344,39 +2771,102 @@ void gfxRealRefreshArea(U16 x, U16 y, U16 w, U16 h)
     areaR2.h = h+4;
     areaR = Clip(areaR, areaR2);
 
-    x = areaR.x;
-    y = areaR.y;
-    w = areaR.w;
-    h = areaR.h;
+    gfxAddDirtyRect(areaR);
+}
 
-    SDL_BlitSurface(Screen, NULL, windowSurface, NULL);
+/* converts & uploads all dirty rectangles and presents the result */
+static void gfxPresentDirty(void)
+{
+    DirtyRegion *dr = &ScreenDirty;
+    Uint64 start;
+    int i;
 
-    if (SDL_LockTexture(sdlTexture, NULL, &pixels, &pitch)) {
-        SDL_ConvertPixels(windowSurface->w, windowSurface->h,
-                windowSurface->format,
-                windowSurface->pixels, windowSurface->pitch,
-                SDL_PIXELFORMAT_XRGB8888,
-                pixels, pitch);
-        SDL_UnlockTexture(sdlTexture);
-    } else {
-        DebugMsg(ERR_WARNING, ERROR_MODULE_GFX,
-                 "SDL_LockTexture failed: %s", SDL_GetError());
+    if (dr->count == 0)
+        return;
+
+    start = gfxProfStart();
+
+    if (setup.Headless) {
+        dr->count = 0;
+
+        gfxSinkFrame(Screen, ScreenLUT);
+
+        gfxProfStop(GFX_PROF_CONVERT, start);
+        return;
+    }
+
+    for (i = 0; i < dr->count; i++) {
+        SDL_Rect rect;
+        void *pixels;
+        int pitch;
+
+        rect.x = dr->rect[i].x;
+        rect.y = dr->rect[i].y;
+        rect.w = dr->rect[i].w;
+        rect.h = dr->rect[i].h;
+
+        /* locking a sub rectangle only uploads that part of the texture */
+        if (SDL_LockTexture(sdlTexture, &rect, &pixels, &pitch)) {
+            const U8 *sp = (const U8 *) Screen->pixels +
+                rect.y * Screen->pitch + rect.x;
+            U8 *dp = pixels;
+            int y;
+
+            /* straight from the 8-bit screen into the texture memory */
+            for (y = 0; y < rect.h; y++) {
+                gfxConvertRow((U32 *) dp, sp, rect.w, ScreenLUT);
+
+                sp += Screen->pitch;
+                dp += pitch;
+            }
+
+            SDL_UnlockTexture(sdlTexture);
+        } else {
+            DebugMsg(ERR_WARNING, ERROR_MODULE_GFX,
+                     "SDL_LockTexture failed: %s", SDL_GetError());
+        }
     }
 
+    dr->count = 0;
+
+    gfxProfStop(GFX_PROF_CONVERT, start);
+    start = gfxProfStart();
+
     SDL_SetRenderDrawColor(sdlRenderer, 0, 0, 0, SDL_ALPHA_OPAQUE);
     SDL_RenderClear(sdlRenderer);
     SDL_RenderTexture(sdlRenderer, sdlTexture, NULL, NULL);
     SDL_RenderPresent(sdlRenderer);
+    FrameTimer.presented = true;
+
+    gfxProfStop(GFX_PROF_PRESENT, start);
+}
+
+/* ZZZ */
+void gfxRealRefreshArea(U16 x, U16 y, U16 w, U16 h)
+{
+    gfxMarkDirty(x, y, w, h);
+    gfxPresentDirty();
 }
 
 
+/*
+ * A refresh only marks the area as dirty. The frame is presented once
+ * per frame by gfxWaitTOF (or an explicit gfxFlush), so a menu redraw
+ * no longer causes a dozen presents within one vsync.
+ */
 void gfxRefreshArea(U16 x, U16 y, U16 w, U16 h)
 {
     if (screen_freeze_count == 0) {
-        gfxRealRefreshArea(x, y, w, h);
+        gfxProfCount(GFX_PROF_REFRESHES);
+        gfxMarkDirty(x, y, w, h);
     }
 }
 
+void gfxFlush(void)
+{
+    gfxPresentDirty();
+}
+
 void gfxScreenFreeze(void)
 {
     screen_freeze_count++;
@@ -2410,7 +2900,7 @@ void MemBlit(MemRastPort *src, Rect *src_rect,
              MemRastPort *dst, Rect *dst_rect, ROpE op)
 {
     Rectangle srcR, srcR2, dstR, dstR2, areaR;
-    U16 sw, dw, x, y;
+    U16 sw, dw, y;
     register U8 *dp, *sp;
 
     /* clip. */
@@ -2457,68 +2947,17 @@ void MemBlit(MemRastPort *src, Rect *src_rect,
     dp += dstR.y * dw + dstR.x;
     sp += srcR.y * sw + srcR.x;
 
-    switch (op) {
-    case GFX_ROP_BLIT:
-        for (y=0; y<areaR.h; y++) {
-            memcpy(dp, sp, areaR.w);
-            dp += dw;
-            sp += sw;
-        }
-        break;
-
-    case GFX_ROP_MASK_BLIT:
-        for (y=0; y<areaR.h; y++) {
-            for (x=0; x<areaR.w; x++) {
-                if (sp[x] != 0) {
-                    dp[x] = sp[x] | (dp[x] & 0x40);
-                }
-            }
-            dp += dw;
-            sp += sw;
-        }
-        break;
-
-    case GFX_ROP_CLR:
-        for (y=0; y<areaR.h; y++) {
-            for (x=0; x<areaR.w; x++) {
-                dp[x] &= ~sp[x];
-            }
-            dp += dw;
-            sp += sw;
-        }
-        break;
-
-    case GFX_ROP_SET:
-        for (y=0; y<areaR.h; y++) {
-            for (x=0; x<areaR.w; x++) {
-                dp[x] |= sp[x];
-            }
-            dp += dw;
-            sp += sw;
-        }
-        break;
+    if (op < GFX_ROP_COUNT) {
+        GfxRopRowFunc rop = gfxRopRow[op];
+        Uint64 start = gfxProfStart();
 
-    case GFX_ROP_OVERLAY:
         for (y=0; y<areaR.h; y++) {
-            for (x=0; x<areaR.w; x++) {
-                if (sp[x] != 0)
-                    dp[x] = sp[x];
-            }
+            rop(dp, sp, areaR.w);
             dp += dw;
             sp += sw;
         }
-        break;
 
-    case GFX_ROP_OVERLAY_MSK:
-        for (y=0; y<areaR.h; y++) {
-            for (x=0; x<areaR.w; x++) {
-                if (sp[x] != 0)
-                    dp[x] = sp[x] | (dp[x] & 0x40);
-            }
-            dp += dw;
-            sp += sw;
-        }
-        break;
+        gfxProfStop(GFX_PROF_BLIT, start);
     }
 }
 
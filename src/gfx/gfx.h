@@ -66,6 +66,7 @@ typedef enum {
 
 typedef struct _MemRastPort MemRastPort;
 typedef struct _Rect        Rect;
+typedef struct _Spans       Spans;
 typedef struct Font         Font;
 
 struct _MemRastPort {
@@ -85,6 +86,18 @@ struct _MemRastPort {
 void gfxInitMemRastPort(MemRastPort *rp, U16 width, U16 height);
 void gfxDoneMemRastPort(MemRastPort *rp);
 
+/* runs of opaque (non-zero) pixels in each row of a MemRastPort */
+struct _Spans {
+    U16 h;
+
+    U32 *rows;                  /* first run of each row, h + 1 entries */
+    U16 *runs;                  /* start and length of each run */
+    U32 count;
+};
+
+void gfxInitSpans(Spans *spans, const MemRastPort *rp);
+void gfxDoneSpans(Spans *spans);
+
 void gfxScratchFromMem(MemRastPort *src);
 void gfxScratchToMem(MemRastPort *dst);
 
@@ -107,6 +120,7 @@ struct Collection {
     char *puch_Filename;
 
     MemRastPort *prepared;
+    MemRastPort *packed;        /* read-only copy in the picture pack */
 
     void *p_ColorTable;		/* not always correct (only as long as nothing
   				   else modified the buffer!) */
@@ -137,7 +151,8 @@ struct Picture {
 };
 
 struct Font {
-    SDL_Surface *bmp;
+    U8 *glyphs;                 /* atlas: w * h bytes per glyph, 0xff = set */
+    U8 *spans;                  /* first and last+1 set column of each glyph row */
 
     U16 w;	                /* width of one character */
     U16 h;	                /* height of one character */
@@ -201,6 +216,10 @@ extern void gfxPrintExact(GC *gc, const char *txt, U16 x, U16 y);
 extern void gfxSetColorRange(ubyte uch_ColorStart, ubyte uch_ColorEnd);
 
 extern void gfxChangeColors(GC *gc, U32 delay, U32 mode, U8 *palette);
+void gfxStartFade(GC *gc, U32 delay, U32 mode, U8 *palette);
+bool gfxFadeStep(void);
+bool gfxFadeActive(void);
+void gfxFinishFade(void);
 extern void gfxShow(uword us_PictId, U32 ul_Mode, S32 l_Delay, S32 l_XPos,
 		    S32 l_YPos);
 
@@ -216,6 +235,29 @@ extern struct Collection *gfxGetCollection(uword us_CollId);
 extern struct Picture *gfxGetPicture(uword us_PictId);
 
 void gfxLoadILBM(char *fileName);
+void gfxLoadILBMToRP(char *fileName, MemRastPort *rp);
+
+/* decoded collections are kept in a LRU cache (see gfxcache.c) */
+#define GFX_COLL_CACHE_DEFAULT_KB      4096
+#define GFX_COLL_CACHE_MAX_KB          (1024 * 1024)
+
+typedef struct {
+    U32 hits;
+    U32 misses;
+    U32 evictions;
+
+    size_t used;                /* bytes */
+    size_t limit;               /* bytes */
+} GfxCollCacheStats;
+
+void gfxPinColl(U16 collId, bool pin);
+void gfxGetCollCacheStats(GfxCollCacheStats *stats);
+
+void gfxInitCollList(void);
+void gfxDoneCollList(void);
+
+/* pre-decoded collections are mapped from a picture pack (see gfxpack.c) */
+bool gfxBuildCollPack(void);
 
 void gfxWaitTOF(void);
 void gfxWaitTOR(void);
@@ -235,16 +277,23 @@ typedef enum {
     GFX_ROP_CLR       = 2,
     GFX_ROP_SET       = 3,
     GFX_ROP_OVERLAY   = 4,
-    GFX_ROP_OVERLAY_MSK = 5
+    GFX_ROP_OVERLAY_MSK = 5,
+    GFX_ROP_LIGHT     = 6,  /* copy with the brightness bit set */
+    GFX_ROP_COUNT
 } ROpE;
 
 void gfxBlit(GC *gc, MemRastPort *src, U16 sx, U16 sy, U16 dx, U16 dy,
              U16 w, U16 h, bool has_mask);
+void gfxBlitROp(GC *gc, MemRastPort *src, U16 sx, U16 sy, U16 dx, U16 dy,
+                U16 w, U16 h, ROpE op);
+void gfxBlitSpans(GC *gc, MemRastPort *src, const Spans *spans,
+                  U16 sx, U16 sy, U16 dx, U16 dy, U16 w, U16 h);
 
 void MemBlit(MemRastPort *src, Rect *src_rect,
              MemRastPort *dst, Rect *dst_rect, ROpE op);
 
 void gfxRefreshArea(U16 x, U16 y, U16 w, U16 h);
+void gfxFlush(void);
 
 void gfxScreenFreeze(void);
 void gfxScreenThaw(GC *gc, U16 x, U16 y, U16 w, U16 h);
@@ -0,0 +1,196 @@
+/****************************************************************************
+  Copyright (c) 2005 Vasco Alexandre da Silva Costa
+
+  Please read the license terms contained in the LICENSE and
+  publiclicensecontract.doc files which should be contained with this
+  distribution.
+ ****************************************************************************/
+
+#include "base/base.h"
+
+#include "gfx/gfxcache.h"
+
+/*
+ * collection cache
+ *
+ * Keeps the decoded pixels and the palette of recently used collections,
+ * so preparing the same picture again costs a memcpy instead of a file
+ * read and an ILBM decode. The list is kept in LRU order (most recently
+ * used first), pinned collections are never evicted.
+ */
+
+struct CachedColl {
+    NODE Link;
+
+    bool pinned;
+
+    MemRastPort rp;             /* rp.collId is the key */
+};
+
+#define GFX_CACHED_COLL_SIZE    (sizeof(struct CachedColl) + SCREEN_SIZE)
+
+static LIST *CollCache = NULL;
+static GfxCollCacheStats CollCacheStats;
+
+void gfxInitCollCache(size_t limit)
+{
+    memset(&CollCacheStats, 0, sizeof(CollCacheStats));
+    CollCacheStats.limit = limit;
+
+    if (!CollCache)
+        CollCache = CreateList();
+}
+
+static void gfxFreeCachedColl(struct CachedColl *cc)
+{
+    CollCacheStats.used -= GFX_CACHED_COLL_SIZE;
+
+    gfxDoneMemRastPort(&cc->rp);
+    FreeNode(cc);
+}
+
+void gfxDoneCollCache(void)
+{
+    struct CachedColl *cc;
+
+    if (!CollCache)
+        return;
+
+    while ((cc = RemHeadNode(CollCache)))
+        gfxFreeCachedColl(cc);
+
+    FreeList(CollCache);
+    CollCache = NULL;
+}
+
+static struct CachedColl *gfxFindCachedColl(U16 collId)
+{
+    NODE *n;
+
+    for (n = LIST_HEAD(CollCache); NODE_SUCC(n); n = NODE_SUCC(n)) {
+        struct CachedColl *cc = (struct CachedColl *) n;
+
+        if (cc->rp.collId == collId)
+            return cc;
+    }
+
+    return NULL;
+}
+
+/* evicts unpinned collections from the tail until size bytes fit */
+static bool gfxMakeRoom(size_t size)
+{
+    NODE *n = LIST_TAIL(CollCache);
+
+    while (CollCacheStats.used + size > CollCacheStats.limit) {
+        NODE *pred;
+
+        /* reached the head - everything left is pinned */
+        if (!NODE_PRED(n))
+            return false;
+
+        pred = NODE_PRED(n);
+
+        if (!((struct CachedColl *) n)->pinned) {
+            RemNode(n);
+            gfxFreeCachedColl((struct CachedColl *) n);
+
+            CollCacheStats.evictions++;
+        }
+
+        n = pred;
+    }
+
+    return true;
+}
+
+static struct CachedColl *gfxNewCachedColl(U16 collId, char *fileName,
+                                           bool pinned)
+{
+    struct CachedColl *cc;
+
+    if (!pinned && !gfxMakeRoom(GFX_CACHED_COLL_SIZE))
+        return NULL;
+
+    if (!(cc = CreateNode(NULL, sizeof(*cc), NULL)))
+        return NULL;
+
+    gfxInitMemRastPort(&cc->rp, SCREEN_WIDTH, SCREEN_HEIGHT);
+    gfxLoadILBMToRP(fileName, &cc->rp);
+
+    cc->rp.collId = collId;
+    cc->pinned = pinned;
+
+    CollCacheStats.used += GFX_CACHED_COLL_SIZE;
+
+    AddHeadNode(CollCache, cc);
+    return cc;
+}
+
+/* copies a cached collection into the ScratchRP */
+bool gfxCollCacheFetch(U16 collId)
+{
+    struct CachedColl *cc;
+
+    if (!CollCache)
+        return false;
+
+    if (!(cc = gfxFindCachedColl(collId))) {
+        CollCacheStats.misses++;
+        return false;
+    }
+
+    CollCacheStats.hits++;
+
+    /* move to the front (most recently used) */
+    RemNode(cc);
+    AddHeadNode(CollCache, cc);
+
+    gfxScratchFromMem(&cc->rp);
+    return true;
+}
+
+/* decodes a collection into the cache and from there into the ScratchRP */
+bool gfxCollCacheLoad(U16 collId, char *fileName)
+{
+    struct CachedColl *cc;
+
+    if (!CollCache || !CollCacheStats.limit)
+        return false;
+
+    if (!(cc = gfxNewCachedColl(collId, fileName, false)))
+        return false;
+
+    gfxScratchFromMem(&cc->rp);
+    return true;
+}
+
+/*
+ * pinned collections stay in the cache until they are unpinned (and are
+ * decoded right away if they are not cached yet). Collections from the
+ * picture pack are always prepared and never need the cache.
+ */
+void gfxPinColl(U16 collId, bool pin)
+{
+    struct CachedColl *cc;
+    struct Collection *coll;
+
+    if (!CollCache)
+        return;
+
+    if ((cc = gfxFindCachedColl(collId))) {
+        cc->pinned = pin;
+    } else if (pin && (coll = gfxGetCollection(collId)) && !coll->packed) {
+        char pathname[DSK_PATH_MAX];
+
+        dskBuildPathName(DISK_CHECK_FILE, PICTURE_DIRECTORY,
+                         coll->puch_Filename, pathname);
+
+        gfxNewCachedColl(collId, pathname, true);
+    }
+}
+
+void gfxGetCollCacheStats(GfxCollCacheStats *stats)
+{
+    *stats = CollCacheStats;
+}
@@ -0,0 +1,22 @@
+/****************************************************************************
+  Copyright (c) 2005 Vasco Alexandre da Silva Costa
+
+  Please read the license terms contained in the LICENSE and
+  publiclicensecontract.doc files which should be contained with this
+  distribution.
+ ****************************************************************************/
+
+#ifndef MODULE_GFXCACHE
+#define MODULE_GFXCACHE
+
+#include "theclou.h"
+
+#include "gfx/gfx.h"
+
+void gfxInitCollCache(size_t limit);
+void gfxDoneCollCache(void);
+
+bool gfxCollCacheFetch(U16 collId);
+bool gfxCollCacheLoad(U16 collId, char *fileName);
+
+#endif
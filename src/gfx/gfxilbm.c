@@ -0,0 +1,159 @@
+/****************************************************************************
+  Copyright (c) 2005 Vasco Alexandre da Silva Costa
+
+  Please read the license terms contained in the LICENSE and
+  publiclicensecontract.doc files which should be contained with this
+  distribution.
+ ****************************************************************************/
+
+#include "gfx/gfxkern.h"
+#include "gfx/gfxilbm.h"
+
+/*
+ * ILBM decoder
+ *
+ * Only what the game needs: the CMAP chunk and a BODY of up to 8
+ * bitplanes, either raw or ByteRun1 compressed, into a chunky picture
+ * SCREEN_WIDTH pixels wide.
+ */
+
+void gfxSetCMAP(const U8 *src, U8 *palette)
+{
+    /* look for CMAP chunk */
+    while (memcmp(src, "CMAP", 4) != 0)
+	src++;
+
+    src += 4;			/* skip CMAP chunk */
+    src += 4;			/* skip size of CMAP chunk */
+
+    memcpy(palette, src, GFX_PALETTE_SIZE);
+}
+
+static U16 MemRead_U16BE(const U8 *p)
+{
+    return ((U16) p[1] | ((U16) p[0] << 8));
+}
+
+/* longest plane row (in bytes) of a compressed picture we can transpose */
+#define GFX_C2P_MAX_ROW_BYTES   128
+
+/*
+ * Converts one row of up to 8 bitplanes into chunky pixels: each plane
+ * byte is spread to 8 pixels through gfxPlanarSpread, so 8 pixels of
+ * all planes take 8 table lookups instead of 64 bit tests.
+ */
+static void gfxPlanarToChunkyRow(const U8 *plane[8], U16 planes,
+                                 size_t rowBytes, U8 *dst, size_t left)
+{
+    size_t c;
+    U16 s;
+
+    planes = min(planes, 8);
+
+    for (c = 0; c < rowBytes && left >= 8; c++, dst += 8, left -= 8) {
+        U64 v, d;
+
+        v = 0;
+        for (s = 0; s < planes; s++)
+            v |= gfxPlanarSpread[plane[s][c]] << s;
+
+        memcpy(&d, dst, 8);
+        d |= v;
+        memcpy(dst, &d, 8);
+    }
+}
+
+/* unpacks one ByteRun1 row, bytes beyond max are dropped */
+static const U8 *gfxUnpackByteRun1(const U8 *sp, U8 *dst, size_t rowBytes,
+                                   size_t max)
+{
+    size_t n = 0;
+
+    do {
+        uword a = *sp++;	/* Kommando (wiederholen oder übernehmen */
+
+        if (a > 128) {	/* Zeichen wiederholen */
+            U8 y = *sp++;
+
+            for (a = 257 - a; a > 0; a--, n++) {
+                if (n < max)
+                    dst[n] = y;
+            }
+        } else {	/* Zeichen übernehmen */
+            for (a++; a > 0; a--, n++) {
+                if (n < max)
+                    dst[n] = *sp;
+                sp++;
+            }
+        }
+    } while (n < rowBytes);
+
+    return sp;
+}
+
+void gfxILBMToRAW(const U8 *src, U8 *dst, size_t size)
+{
+    static U8 rows[8][GFX_C2P_MAX_ROW_BYTES];
+    U16 bpp = 0, w = 0, h = 0;
+    const U8 *sp;
+    const U8 *plane[8];
+    size_t rowBytes;
+    int s, t;
+    uword flag;
+
+    sp = src;
+
+    sp += 8;
+
+    if (memcmp(sp, "ILBM", 4) != 0) {
+	return;
+    }
+
+    sp += 12;
+
+    w = MemRead_U16BE(sp);
+    sp += 2;
+    h = MemRead_U16BE(sp);
+    sp += 6;
+    bpp = *sp;
+    sp += 2;
+    flag = *sp;
+
+    h = min(h, 192);
+
+    while (memcmp(sp, "BODY", 4) != 0) {
+	sp++;
+    }
+
+    sp += 8;
+
+    memset(dst, 0, size);
+
+    rowBytes = ((w + 15) & 0xfff0) / 8;
+
+    for (t=0; t<h; t++) {
+        size_t offset = (size_t) t * SCREEN_WIDTH;
+
+        for (s=0; s<bpp; s++) {
+            if (flag) {
+                if (s < 8) {
+                    sp = gfxUnpackByteRun1(sp, rows[s], rowBytes,
+                                           GFX_C2P_MAX_ROW_BYTES);
+                    plane[s] = rows[s];
+                } else {
+                    sp = gfxUnpackByteRun1(sp, NULL, rowBytes, 0);
+                }
+            } else {
+                if (s < 8)
+                    plane[s] = sp;
+                sp += rowBytes;
+            }
+        }
+
+        if (offset < size) {
+            gfxPlanarToChunkyRow(plane, bpp,
+                                 flag ? min(rowBytes, GFX_C2P_MAX_ROW_BYTES) : rowBytes,
+                                 dst + offset, size - offset);
+        }
+    }
+}
@@ -0,0 +1,22 @@
+/****************************************************************************
+  Copyright (c) 2005 Vasco Alexandre da Silva Costa
+
+  Please read the license terms contained in the LICENSE and
+  publiclicensecontract.doc files which should be contained with this
+  distribution.
+ ****************************************************************************/
+
+#ifndef MODULE_GFXILBM
+#define MODULE_GFXILBM
+
+#include "theclou.h"
+
+#include "gfx/gfx.h"
+
+/* copies the palette from the CMAP chunk */
+void gfxSetCMAP(const U8 *src, U8 *palette);
+
+/* decodes the BODY chunk into chunky pixels, at most size bytes */
+void gfxILBMToRAW(const U8 *src, U8 *dst, size_t size);
+
+#endif
@@ -0,0 +1,328 @@
+/****************************************************************************
+  Copyright (c) 2005 Vasco Alexandre da Silva Costa
+
+  Please read the license terms contained in the LICENSE and
+  publiclicensecontract.doc files which should be contained with this
+  distribution.
+ ****************************************************************************/
+
+#include <SDL3/SDL.h>
+
+#include "gfx/gfxkern.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define GFX_KERN_X86
+#include <immintrin.h>
+#elif defined(__GNUC__) && defined(__ARM_NEON)
+#define GFX_KERN_NEON
+#include <arm_neon.h>
+#endif
+
+/* rows narrower than this are not worth a vector loop */
+#define GFX_KERN_MIN_VECTOR_WIDTH   16
+
+/*******************************************************************
+ * palette conversion
+ *
+ * There is no cheap 32-bit table lookup in SSE2 or NEON, so apart from
+ * the AVX2 gather everything uses the unrolled scalar loop - it is
+ * bound by the stores anyway.
+ */
+
+static void gfxConvertRowScalar(U32 *dst, const U8 *src, size_t n,
+                                const U32 *lut)
+{
+    while (n >= 8) {
+        dst[0] = lut[src[0]];
+        dst[1] = lut[src[1]];
+        dst[2] = lut[src[2]];
+        dst[3] = lut[src[3]];
+        dst[4] = lut[src[4]];
+        dst[5] = lut[src[5]];
+        dst[6] = lut[src[6]];
+        dst[7] = lut[src[7]];
+
+        dst += 8;
+        src += 8;
+        n -= 8;
+    }
+
+    while (n--)
+        *dst++ = lut[*src++];
+}
+
+#ifdef GFX_KERN_X86
+__attribute__((target("avx2")))
+static void gfxConvertRowAVX2(U32 *dst, const U8 *src, size_t n,
+                              const U32 *lut)
+{
+    while (n >= 8) {
+        __m128i idx8 = _mm_loadl_epi64((const __m128i *) src);
+        __m256i idx = _mm256_cvtepu8_epi32(idx8);
+        __m256i px = _mm256_i32gather_epi32((const int *) lut, idx, 4);
+
+        _mm256_storeu_si256((__m256i *) dst, px);
+
+        dst += 8;
+        src += 8;
+        n -= 8;
+    }
+
+    gfxConvertRowScalar(dst, src, n, lut);
+}
+#endif
+
+/*******************************************************************
+ * raster operations
+ *
+ * The scalar versions are the reference, the vector versions must give
+ * bit identical results. A pixel value of 0 is transparent, bit 0x40 is
+ * the brightness bit of the landscape (see gfxSetDarkness).
+ */
+
+static void gfxRopBlitScalar(U8 *dp, const U8 *sp, size_t n)
+{
+    memcpy(dp, sp, n);
+}
+
+static void gfxRopMaskBlitScalar(U8 *dp, const U8 *sp, size_t n)
+{
+    size_t x;
+
+    for (x=0; x<n; x++) {
+        if (sp[x] != 0)
+            dp[x] = sp[x] | (dp[x] & 0x40);
+    }
+}
+
+static void gfxRopClrScalar(U8 *dp, const U8 *sp, size_t n)
+{
+    size_t x;
+
+    for (x=0; x<n; x++)
+        dp[x] &= ~sp[x];
+}
+
+static void gfxRopSetScalar(U8 *dp, const U8 *sp, size_t n)
+{
+    size_t x;
+
+    for (x=0; x<n; x++)
+        dp[x] |= sp[x];
+}
+
+static void gfxRopOverlayScalar(U8 *dp, const U8 *sp, size_t n)
+{
+    size_t x;
+
+    for (x=0; x<n; x++) {
+        if (sp[x] != 0)
+            dp[x] = sp[x];
+    }
+}
+
+static void gfxRopLightScalar(U8 *dp, const U8 *sp, size_t n)
+{
+    size_t x;
+
+    for (x=0; x<n; x++)
+        dp[x] = sp[x] | 0x40;
+}
+
+#ifdef GFX_KERN_X86
+
+/* SSE2: 16 pixels per step */
+#define GFX_ROP_SSE2(name, expr, scalar) \
+__attribute__((target("sse2"))) \
+static void name(U8 *dp, const U8 *sp, size_t n) \
+{ \
+    const __m128i zero = _mm_setzero_si128(); \
+    const __m128i bright = _mm_set1_epi8(0x40); \
+ \
+    (void) zero; \
+    (void) bright; \
+ \
+    if (n >= GFX_KERN_MIN_VECTOR_WIDTH) { \
+        while (n >= 16) { \
+            __m128i s = _mm_loadu_si128((const __m128i *) sp); \
+            __m128i d = _mm_loadu_si128((const __m128i *) dp); \
+ \
+            _mm_storeu_si128((__m128i *) dp, expr); \
+ \
+            dp += 16; \
+            sp += 16; \
+            n -= 16; \
+        } \
+    } \
+ \
+    scalar(dp, sp, n); \
+}
+
+/* keep d where s is transparent, v everywhere else */
+#define GFX_SSE2_SELECT(s, d, v) \
+    _mm_or_si128(_mm_and_si128(_mm_cmpeq_epi8((s), zero), (d)), \
+                 _mm_andnot_si128(_mm_cmpeq_epi8((s), zero), (v)))
+
+GFX_ROP_SSE2(gfxRopMaskBlitSSE2,
+             GFX_SSE2_SELECT(s, d, _mm_or_si128(s, _mm_and_si128(d, bright))),
+             gfxRopMaskBlitScalar)
+GFX_ROP_SSE2(gfxRopClrSSE2, _mm_andnot_si128(s, d), gfxRopClrScalar)
+GFX_ROP_SSE2(gfxRopSetSSE2, _mm_or_si128(s, d), gfxRopSetScalar)
+GFX_ROP_SSE2(gfxRopOverlaySSE2, GFX_SSE2_SELECT(s, d, s),
+             gfxRopOverlayScalar)
+GFX_ROP_SSE2(gfxRopLightSSE2, ((void) d, _mm_or_si128(s, bright)),
+             gfxRopLightScalar)
+
+/* AVX2: 32 pixels per step, the remainder goes through SSE2 */
+#define GFX_ROP_AVX2(name, expr, tail) \
+__attribute__((target("avx2"))) \
+static void name(U8 *dp, const U8 *sp, size_t n) \
+{ \
+    const __m256i zero = _mm256_setzero_si256(); \
+    const __m256i bright = _mm256_set1_epi8(0x40); \
+ \
+    (void) zero; \
+    (void) bright; \
+ \
+    while (n >= 32) { \
+        __m256i s = _mm256_loadu_si256((const __m256i *) sp); \
+        __m256i d = _mm256_loadu_si256((const __m256i *) dp); \
+ \
+        _mm256_storeu_si256((__m256i *) dp, expr); \
+ \
+        dp += 32; \
+        sp += 32; \
+        n -= 32; \
+    } \
+ \
+    tail(dp, sp, n); \
+}
+
+#define GFX_AVX2_SELECT(s, d, v) \
+    _mm256_blendv_epi8((v), (d), _mm256_cmpeq_epi8((s), zero))
+
+GFX_ROP_AVX2(gfxRopMaskBlitAVX2,
+             GFX_AVX2_SELECT(s, d, _mm256_or_si256(s, _mm256_and_si256(d, bright))),
+             gfxRopMaskBlitSSE2)
+GFX_ROP_AVX2(gfxRopClrAVX2, _mm256_andnot_si256(s, d), gfxRopClrSSE2)
+GFX_ROP_AVX2(gfxRopSetAVX2, _mm256_or_si256(s, d), gfxRopSetSSE2)
+GFX_ROP_AVX2(gfxRopOverlayAVX2, GFX_AVX2_SELECT(s, d, s),
+             gfxRopOverlaySSE2)
+GFX_ROP_AVX2(gfxRopLightAVX2, ((void) d, _mm256_or_si256(s, bright)),
+             gfxRopLightSSE2)
+
+#endif
+
+#ifdef GFX_KERN_NEON
+
+/* NEON: 16 pixels per step */
+#define GFX_ROP_NEON(name, expr, scalar) \
+static void name(U8 *dp, const U8 *sp, size_t n) \
+{ \
+    const uint8x16_t zero = vdupq_n_u8(0); \
+    const uint8x16_t bright = vdupq_n_u8(0x40); \
+ \
+    (void) zero; \
+    (void) bright; \
+ \
+    if (n >= GFX_KERN_MIN_VECTOR_WIDTH) { \
+        while (n >= 16) { \
+            uint8x16_t s = vld1q_u8(sp); \
+            uint8x16_t d = vld1q_u8(dp); \
+ \
+            vst1q_u8(dp, expr); \
+ \
+            dp += 16; \
+            sp += 16; \
+            n -= 16; \
+        } \
+    } \
+ \
+    scalar(dp, sp, n); \
+}
+
+#define GFX_NEON_SELECT(s, d, v) vbslq_u8(vceqq_u8((s), zero), (d), (v))
+
+GFX_ROP_NEON(gfxRopMaskBlitNEON,
+             GFX_NEON_SELECT(s, d, vorrq_u8(s, vandq_u8(d, bright))),
+             gfxRopMaskBlitScalar)
+GFX_ROP_NEON(gfxRopClrNEON, vbicq_u8(d, s), gfxRopClrScalar)
+GFX_ROP_NEON(gfxRopSetNEON, vorrq_u8(s, d), gfxRopSetScalar)
+GFX_ROP_NEON(gfxRopOverlayNEON, GFX_NEON_SELECT(s, d, s),
+             gfxRopOverlayScalar)
+GFX_ROP_NEON(gfxRopLightNEON, ((void) d, vorrq_u8(s, bright)),
+             gfxRopLightScalar)
+
+#endif
+
+/*******************************************************************
+ * planar to chunky
+ */
+
+U64 gfxPlanarSpread[256];
+
+static void gfxInitPlanarSpread(void)
+{
+    int b, i;
+
+    for (b = 0; b < 256; b++) {
+        U8 pixels[8];
+
+        for (i = 0; i < 8; i++)
+            pixels[i] = (b >> (7 - i)) & 1;
+
+        memcpy(&gfxPlanarSpread[b], pixels, 8);
+    }
+}
+
+GfxConvertRowFunc gfxConvertRow = gfxConvertRowScalar;
+
+GfxRopRowFunc gfxRopRow[GFX_ROP_COUNT] = {
+    gfxRopBlitScalar,           /* GFX_ROP_BLIT */
+    gfxRopMaskBlitScalar,       /* GFX_ROP_MASK_BLIT */
+    gfxRopClrScalar,            /* GFX_ROP_CLR */
+    gfxRopSetScalar,            /* GFX_ROP_SET */
+    gfxRopOverlayScalar,        /* GFX_ROP_OVERLAY */
+    gfxRopMaskBlitScalar,       /* GFX_ROP_OVERLAY_MSK */
+    gfxRopLightScalar           /* GFX_ROP_LIGHT */
+};
+
+static void gfxSetRops(GfxRopRowFunc maskBlit, GfxRopRowFunc clr,
+                       GfxRopRowFunc set, GfxRopRowFunc overlay,
+                       GfxRopRowFunc light)
+{
+    gfxRopRow[GFX_ROP_BLIT]        = gfxRopBlitScalar;
+    gfxRopRow[GFX_ROP_MASK_BLIT]   = maskBlit;
+    gfxRopRow[GFX_ROP_CLR]         = clr;
+    gfxRopRow[GFX_ROP_SET]         = set;
+    gfxRopRow[GFX_ROP_OVERLAY]     = overlay;
+    gfxRopRow[GFX_ROP_OVERLAY_MSK] = maskBlit;
+    gfxRopRow[GFX_ROP_LIGHT]       = light;
+}
+
+void gfxKernInit(void)
+{
+    gfxInitPlanarSpread();
+
+    gfxConvertRow = gfxConvertRowScalar;
+    gfxSetRops(gfxRopMaskBlitScalar, gfxRopClrScalar,
+               gfxRopSetScalar, gfxRopOverlayScalar, gfxRopLightScalar);
+
+#ifdef GFX_KERN_X86
+    if (SDL_HasSSE2()) {
+        gfxSetRops(gfxRopMaskBlitSSE2, gfxRopClrSSE2,
+                   gfxRopSetSSE2, gfxRopOverlaySSE2, gfxRopLightSSE2);
+    }
+
+    if (SDL_HasAVX2()) {
+        gfxConvertRow = gfxConvertRowAVX2;
+        gfxSetRops(gfxRopMaskBlitAVX2, gfxRopClrAVX2,
+                   gfxRopSetAVX2, gfxRopOverlayAVX2, gfxRopLightAVX2);
+    }
+#endif
+
+#ifdef GFX_KERN_NEON
+    gfxSetRops(gfxRopMaskBlitNEON, gfxRopClrNEON,
+               gfxRopSetNEON, gfxRopOverlayNEON, gfxRopLightNEON);
+#endif
+}
@@ -0,0 +1,44 @@
+/****************************************************************************
+  Copyright (c) 2005 Vasco Alexandre da Silva Costa
+
+  Please read the license terms contained in the LICENSE and
+  publiclicensecontract.doc files which should be contained with this
+  distribution.
+ ****************************************************************************/
+
+#ifndef MODULE_GFXKERN
+#define MODULE_GFXKERN
+
+#include "theclou.h"
+
+#include "gfx/gfx.h"
+
+/*
+ * pixel kernels
+ *
+ * The inner loops of the gfx module. gfxKernInit picks the fastest
+ * implementation the cpu supports once, all other calls go through
+ * the selected function pointers.
+ */
+
+/* converts n 8-bit pixels to XRGB8888 through a 256 entry lookup table */
+typedef void (*GfxConvertRowFunc)(U32 *dst, const U8 *src, size_t n,
+                                  const U32 *lut);
+
+extern GfxConvertRowFunc gfxConvertRow;
+
+/* applies a raster operation to n pixels of one row (see MemBlit) */
+typedef void (*GfxRopRowFunc)(U8 *dp, const U8 *sp, size_t n);
+
+extern GfxRopRowFunc gfxRopRow[GFX_ROP_COUNT];
+
+/*
+ * bitplane byte spread to 8 chunky pixels: pixel i (in memory order) is
+ * bit 7-i of the index, so (gfxPlanarSpread[b] << plane) puts the plane
+ * bit of 8 pixels in place at once
+ */
+extern U64 gfxPlanarSpread[256];
+
+void gfxKernInit(void);
+
+#endif
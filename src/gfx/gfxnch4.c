@@ -15,37 +15,96 @@
 
 int ScrX, ScrY;
 
-static U8 ScrDark;
+static U8 ScrDark = LS_DARKNESS;
 
-void gfxSetDarkness(U8 value)
+/*
+ * Tiles of the landscape that were drawn to since the last refresh, one
+ * bit per tile and a word per row of tiles. Like a full refresh used to,
+ * the next refresh of the view shows them, so a door and a spot at
+ * opposite ends of the view cost a few tiles and not the area between.
+ */
+#define GFX_LS_TILE_SIZE    16
+#define GFX_LS_TILE_COLS    (LS_MAX_AREA_WIDTH / GFX_LS_TILE_SIZE)
+#define GFX_LS_TILE_ROWS    (LS_MAX_AREA_HEIGHT / GFX_LS_TILE_SIZE)
+
+static U64 LSDirty[GFX_LS_TILE_ROWS];
+
+static void gfxLSResetDirty(void)
 {
-    U8 *dp;
-    int h, i;
+    memset(LSDirty, 0, sizeof(LSDirty));
+}
 
-    dp = LSRPInMem.pixels;
+void gfxLSMarkDirty(int x, int y, int w, int h)
+{
+    int c0, c1, r0, r1;
+    U64 mask;
 
-    if (value == LS_BRIGHTNESS) {
-        h = LS_MAX_AREA_WIDTH;
+    x = max(x, 0);
+    y = max(y, 0);
+    w = min(x + w, LS_MAX_AREA_WIDTH) - x;
+    h = min(y + h, LS_MAX_AREA_HEIGHT) - y;
 
-        do {
-            i = LS_MAX_AREA_HEIGHT;
+    if (w <= 0 || h <= 0)
+        return;
 
-            do {
-                *dp++ |= 64;
-            } while (--i);
-        } while (--h);
-    } else {
-        h = LS_MAX_AREA_WIDTH;
+    c0 = x / GFX_LS_TILE_SIZE;
+    c1 = (x + w - 1) / GFX_LS_TILE_SIZE;
+    r0 = y / GFX_LS_TILE_SIZE;
+    r1 = (y + h - 1) / GFX_LS_TILE_SIZE;
 
-        do {
-            i = LS_MAX_AREA_HEIGHT;
+    mask = ((~(U64) 0) >> (63 - (c1 - c0))) << c0;
 
-            do {
-                *dp++ &= ~64;
-            } while (--i);
-        } while (--h);
+    for (; r0 <= r1; r0++)
+        LSDirty[r0] |= mask;
+}
+
+/*
+ * One bit per landscape pixel, set where the pixel has one of the
+ * collision colours. It is kept up to date by everything that draws to
+ * the landscape, so collision tests neither read LSRPInMem nor compare
+ * colours, and a row of the area fits into 20 words.
+ */
+#define GFX_LS_COLLIS_WORDS (LS_MAX_AREA_WIDTH / 32)
+
+static U32 LSCollis[LS_MAX_AREA_HEIGHT][GFX_LS_COLLIS_WORDS];
+
+static void gfxLSUpdateCollis(int x, int y, int w, int h)
+{
+    x = max(x, 0);
+    y = max(y, 0);
+    w = min(x + w, LS_MAX_AREA_WIDTH) - x;
+    h = min(y + h, LS_MAX_AREA_HEIGHT) - y;
+
+    for (; h > 0; h--, y++) {
+        const U8 *sp = LSRPInMem.pixels + y * LS_MAX_AREA_WIDTH;
+        U32 *row = LSCollis[y];
+        int i;
+
+        for (i = x; i < x + w; i++) {
+            U32 bit = (U32) 1 << (i & 31);
+
+            if (LS_IS_COLLIS_COLOR(sp[i]))
+                row[i >> 5] |= bit;
+            else
+                row[i >> 5] &= ~bit;
+        }
     }
+}
 
+void gfxLSMarkChanged(int x, int y, int w, int h)
+{
+    gfxLSUpdateCollis(x, y, w, h);
+    gfxLSMarkDirty(x, y, w, h);
+}
+
+/*
+ * Bit 6 of a landscape pixel selects the bright half of the palette. In
+ * LSRPInMem it is only set where a spot lights the floor; a lit area
+ * gets the bit while the landscape is copied to the screen, so switching
+ * the lights does not touch the landscape buffer at all.
+ */
+void gfxSetDarkness(U8 value)
+{
     ScrDark = value;
 
     gfxNCH4Refresh();
@@ -53,17 +112,82 @@ void gfxSetDarkness(U8 value)
 
 void gfxNCH4Refresh(void)
 {
+    gfxLSResetDirty();
+
     gfxScreenFreeze();
 
-    gfxBlit(u_gc, &LSRPInMem, ScrX, ScrY, 0, 0,
-        LS_MAX_AREA_WIDTH, LS_MAX_AREA_HEIGHT, false);
+    gfxBlitROp(u_gc, &LSRPInMem, ScrX, ScrY, 0, 0,
+        LS_MAX_AREA_WIDTH, LS_MAX_AREA_HEIGHT,
+        (ScrDark == LS_BRIGHTNESS) ? GFX_ROP_LIGHT : GFX_ROP_BLIT);
 
     BobDisplayLists(u_gc);
 
-    gfxScreenThaw(u_gc, 0, 0, 320, 128);
+    gfxScreenThaw(u_gc, 0, 0, GFX_NCH4_VIEW_WIDTH, GFX_NCH4_VIEW_HEIGHT);
 /*printf("REFRESH!\n");*/
 }
 
+/* restores the landscape under one area and draws the bobs over it again */
+static void gfxNCH4RedrawArea(int x, int y, int w, int h)
+{
+    int x0, y0, x1, y1;
+
+    x0 = max(x, ScrX);
+    y0 = max(y, ScrY);
+    x1 = min(x + w, min(ScrX + GFX_NCH4_VIEW_WIDTH, LS_MAX_AREA_WIDTH));
+    y1 = min(y + h, min(ScrY + GFX_NCH4_VIEW_HEIGHT, LS_MAX_AREA_HEIGHT));
+
+    if (x0 >= x1 || y0 >= y1)
+        return;
+
+    gfxScreenFreeze();
+
+    gfxBlitROp(u_gc, &LSRPInMem, x0, y0, x0 - ScrX, y0 - ScrY,
+        x1 - x0, y1 - y0,
+        (ScrDark == LS_BRIGHTNESS) ? GFX_ROP_LIGHT : GFX_ROP_BLIT);
+
+    BobDisplayArea(u_gc, x0, y0, x1 - x0, y1 - y0);
+
+    gfxScreenThaw(u_gc, x0 - ScrX, y0 - ScrY, x1 - x0, y1 - y0);
+}
+
+/*
+ * redraws the dirty tiles, rows with the same dirty tiles are done
+ * together and so are neighbouring tiles of a row
+ */
+static void gfxLSFlushDirty(void)
+{
+    U64 dirty[GFX_LS_TILE_ROWS];
+    int r0, r1, c0, c1;
+
+    memcpy(dirty, LSDirty, sizeof(dirty));
+    gfxLSResetDirty();
+
+    for (r0 = 0; r0 < GFX_LS_TILE_ROWS; r0 = r1) {
+        U64 mask = dirty[r0];
+
+        for (r1 = r0 + 1; r1 < GFX_LS_TILE_ROWS && dirty[r1] == mask; r1++);
+
+        for (c0 = 0; mask >> c0; c0 = c1) {
+            if (!((mask >> c0) & 1)) {
+                c1 = c0 + 1;
+                continue;
+            }
+
+            for (c1 = c0 + 1; c1 < GFX_LS_TILE_COLS && ((mask >> c1) & 1); c1++);
+
+            gfxNCH4RedrawArea(c0 * GFX_LS_TILE_SIZE, r0 * GFX_LS_TILE_SIZE,
+                              (c1 - c0) * GFX_LS_TILE_SIZE,
+                              (r1 - r0) * GFX_LS_TILE_SIZE);
+        }
+    }
+}
+
+void gfxNCH4RefreshArea(int x, int y, int w, int h)
+{
+    gfxLSFlushDirty();
+    gfxNCH4RedrawArea(x, y, w, h);
+}
+
 void gfxNCH4SetViewPort(int x, int y)
 {
     ScrX = x;
@@ -90,6 +214,9 @@ void gfxLSInit(void)
 {
     ScrX = 0;
     ScrY = 0;
+    ScrDark = LS_DARKNESS;
+
+    gfxLSResetDirty();
 
     gfxLSRectFill(0, 0, LS_MAX_AREA_WIDTH-1, LS_MAX_AREA_HEIGHT-1, 0);
 }
@@ -109,6 +236,7 @@ void gfxLSPut(MemRastPort *sp, U16 sx, U16 sy, U16 dx, U16 dy, U16 w, U16 h)
     dstR.h = h;
 
     MemBlit(sp, &srcR, &LSRPInMem, &dstR, GFX_ROP_BLIT);
+    gfxLSMarkChanged(dx, dy, w, h);
 }
 
 void gfxLSPutMsk(MemRastPort *sp, U16 sx, U16 sy, U16 dx, U16 dy, U16 w, U16 h)
@@ -126,6 +254,7 @@ void gfxLSPutMsk(MemRastPort *sp, U16 sx, U16 sy, U16 dx, U16 dy, U16 w, U16 h)
     dstR.h = h;
 
     MemBlit(sp, &srcR, &LSRPInMem, &dstR, GFX_ROP_MASK_BLIT);
+    gfxLSMarkChanged(dx, dy, w, h);
 }
 
 void gfxLSOverlay(MemRastPort *sp, U16 sx, U16 sy, U16 dx, U16 dy, U16 w, U16 h)
@@ -143,6 +272,7 @@ void gfxLSOverlay(MemRastPort *sp, U16 sx, U16 sy, U16 dx, U16 dy, U16 w, U16 h)
     dstR.h = h;
 
     MemBlit(sp, &srcR, &LSRPInMem, &dstR, GFX_ROP_OVERLAY);
+    gfxLSMarkChanged(dx, dy, w, h);
 }
 
 void gfxLSOverlayMask(MemRastPort *sp, U16 sx, U16 sy, U16 dx, U16 dy, U16 w, U16 h)
@@ -160,6 +290,7 @@ void gfxLSOverlayMask(MemRastPort *sp, U16 sx, U16 sy, U16 dx, U16 dy, U16 w, U1
     dstR.h = h;
 
     MemBlit(sp, &srcR, &LSRPInMem, &dstR, GFX_ROP_OVERLAY_MSK);
+    gfxLSMarkChanged(dx, dy, w, h);
 }
 
 void gfxLSPutClr(MemRastPort *sp, U16 sx, U16 sy, U16 dx, U16 dy, U16 w, U16 h)
@@ -177,6 +308,7 @@ void gfxLSPutClr(MemRastPort *sp, U16 sx, U16 sy, U16 dx, U16 dy, U16 w, U16 h)
     dstR.h = h;
 
     MemBlit(sp, &srcR, &LSRPInMem, &dstR, GFX_ROP_CLR);
+    gfxLSMarkChanged(dx, dy, w, h);
 }
 
 void gfxLSPutSet(MemRastPort *sp, U16 sx, U16 sy, U16 dx, U16 dy, U16 w, U16 h)
@@ -194,6 +326,7 @@ void gfxLSPutSet(MemRastPort *sp, U16 sx, U16 sy, U16 dx, U16 dy, U16 w, U16 h)
     dstR.h = h;
 
     MemBlit(sp, &srcR, &LSRPInMem, &dstR, GFX_ROP_SET);
+    gfxLSMarkChanged(dx, dy, w, h);
 }
 
 void gfxLSRectFill(U16 sx, U16 sy, U16 ex, U16 ey, U8 color)
@@ -222,10 +355,12 @@ void gfxLSRectFill(U16 sx, U16 sy, U16 ex, U16 ey, U8 color)
     dp = LSRPInMem.pixels;
     dp += sy * LS_MAX_AREA_WIDTH + sx;
 
-    do {
+    for (tmp = h; tmp; tmp--) {
         memset(dp, color, w);
         dp += LS_MAX_AREA_WIDTH;
-    } while (--h);
+    }
+
+    gfxLSMarkChanged(sx, sy, w, h);
 }
 
 U8 gfxLSReadPixel(U16 x, U16 y)
@@ -235,3 +370,11 @@ U8 gfxLSReadPixel(U16 x, U16 y)
 
     return LSRPInMem.pixels[y * LS_MAX_AREA_WIDTH + x];
 }
+
+bool gfxLSIsCollis(U16 x, U16 y)
+{
+    x = min(x, LS_MAX_AREA_WIDTH-1);
+    y = min(y, LS_MAX_AREA_HEIGHT-1);
+
+    return (LSCollis[y][x >> 5] >> (x & 31)) & 1;
+}
@@ -30,12 +30,17 @@
 #define ScrTOP 0
 #define ScrBOTTOM 255
 
+/* size of the landscape view on screen */
+#define GFX_NCH4_VIEW_WIDTH     320
+#define GFX_NCH4_VIEW_HEIGHT    128
+
 struct RastPort;
 
 extern U32 gfxNCH4GetCurrScrollOffset(void);
 void gfxSetDarkness(ubyte value);
 
 void gfxNCH4Refresh(void);
+void gfxNCH4RefreshArea(int x, int y, int w, int h);
 
 extern void gfxNCH4SetViewPort(int x, int y);
 extern void gfxNCH4Scroll(int x, int y);
@@ -50,5 +55,8 @@ void gfxLSPutClr(MemRastPort *sp, U16 sx, U16 sy, U16 dx, U16 dy, U16 w, U16 h);
 void gfxLSPutSet(MemRastPort *sp, U16 sx, U16 sy, U16 dx, U16 dy, U16 w, U16 h);
 
 void gfxLSRectFill(U16 sx, U16 sy, U16 ex, U16 ey, U8 color);
+void gfxLSMarkDirty(int x, int y, int w, int h);
+void gfxLSMarkChanged(int x, int y, int w, int h);
 U8 gfxLSReadPixel(U16 x, U16 y);
+bool gfxLSIsCollis(U16 x, U16 y);
 #endif
@@ -0,0 +1,314 @@
+/****************************************************************************
+  Copyright (c) 2005 Vasco Alexandre da Silva Costa
+
+  Please read the license terms contained in the LICENSE and
+  publiclicensecontract.doc files which should be contained with this
+  distribution.
+ ****************************************************************************/
+
+#include "base/base.h"
+
+#include "gfx/gfxkern.h"
+#include "gfx/gfxpack.h"
+
+/*
+ * picture pack
+ *
+ * The pack holds every collection already decoded to chunky pixels, so
+ * preparing a packed collection neither reads nor decodes a file. At
+ * runtime the pack is mapped read-only and the prepared MemRastPort of
+ * each collection points straight into the mapping; the pages are shared
+ * by all running instances through the page cache.
+ *
+ * Each entry records the size and modification time of the ILBM it was
+ * decoded from. Entries whose ILBM has changed since are ignored and the
+ * collection is decoded from the file as usual.
+ *
+ * layout (all numbers little endian):
+ *
+ *   header     "TCPK", U32 version, U32 count, U32 reserved
+ *   directory  count * { U16 collId, U16 width, U16 height, U16 reserved,
+ *                        U32 offset, U32 srcSize, U64 srcTime }
+ *   pictures   width * height pixels followed by the palette, each
+ *              picture starts on a GFX_PACK_ALIGN boundary
+ */
+
+#define GFX_PACK_MAGIC          "TCPK"
+#define GFX_PACK_VERSION        2
+
+#define GFX_PACK_ALIGN          4096
+#define GFX_PACK_HEADER_SIZE    16
+#define GFX_PACK_ENTRY_SIZE     24
+
+#define GFX_PACK_ALIGNED(n)     (((n) + GFX_PACK_ALIGN - 1) & ~(U32) (GFX_PACK_ALIGN - 1))
+
+static U8 *PackBase = NULL;
+static size_t PackSize = 0;
+
+static MemRastPort *PackRPs = NULL;
+static U32 PackEntries = 0;
+
+static U16 gfxPackGet_U16LE(const U8 *p)
+{
+    return ((U16) p[0] | ((U16) p[1] << 8));
+}
+
+static U32 gfxPackGet_U32LE(const U8 *p)
+{
+    return ((U32) p[0] | ((U32) p[1] << 8) | ((U32) p[2] << 16) | ((U32) p[3] << 24));
+}
+
+static U64 gfxPackGet_U64LE(const U8 *p)
+{
+    return ((U64) gfxPackGet_U32LE(p) | ((U64) gfxPackGet_U32LE(p + 4) << 32));
+}
+
+static void gfxPackPut_U16LE(U8 *p, U16 x)
+{
+    p[0] = (U8) (x & 0xff);
+    p[1] = (U8) ((x >> 8) & 0xff);
+}
+
+static void gfxPackPut_U32LE(U8 *p, U32 x)
+{
+    p[0] = (U8) (x & 0xff);
+    p[1] = (U8) ((x >> 8) & 0xff);
+    p[2] = (U8) ((x >> 16) & 0xff);
+    p[3] = (U8) ((x >> 24) & 0xff);
+}
+
+static void gfxPackPut_U64LE(U8 *p, U64 x)
+{
+    gfxPackPut_U32LE(p, (U32) (x & 0xffffffff));
+    gfxPackPut_U32LE(p + 4, (U32) (x >> 32));
+}
+
+static bool gfxCollPathName(struct Collection *coll, char *pathname)
+{
+    return dskBuildPathName(DISK_CHECK_FILE, PICTURE_DIRECTORY,
+                            coll->puch_Filename, pathname);
+}
+
+/* an entry is stale if its ILBM is there and differs from the one packed */
+static bool gfxPackIsStale(struct Collection *coll, const U8 *entry)
+{
+    char pathname[DSK_PATH_MAX];
+
+    if (!gfxCollPathName(coll, pathname))
+        return false;
+
+    return dskFileLength(pathname) != gfxPackGet_U32LE(entry + 12)
+        || dskFileTime(pathname) != gfxPackGet_U64LE(entry + 16);
+}
+
+void gfxInitCollPack(void)
+{
+    char pathname[DSK_PATH_MAX];
+    U32 i, count, packed = 0;
+
+    if (!dskBuildPathName(DISK_CHECK_FILE, PICTURE_DIRECTORY, GFX_PACK_NAME, pathname))
+        return;
+
+    if (!(PackBase = dskMap(pathname, &PackSize)))
+        return;
+
+    if (PackSize < GFX_PACK_HEADER_SIZE
+        || memcmp(PackBase, GFX_PACK_MAGIC, 4) != 0
+        || gfxPackGet_U32LE(PackBase + 4) != GFX_PACK_VERSION) {
+        DebugMsg(ERR_WARNING, ERROR_MODULE_GFX, "ignoring %s: bad header", pathname);
+        gfxDoneCollPack();
+        return;
+    }
+
+    count = gfxPackGet_U32LE(PackBase + 8);
+
+    if (!count || count > (PackSize - GFX_PACK_HEADER_SIZE) / GFX_PACK_ENTRY_SIZE) {
+        DebugMsg(ERR_WARNING, ERROR_MODULE_GFX, "ignoring %s: bad directory", pathname);
+        gfxDoneCollPack();
+        return;
+    }
+
+    PackEntries = count;
+    PackRPs = TCAllocMem(PackEntries * sizeof(*PackRPs), true);
+
+    for (i = 0; i < count; i++) {
+        const U8 *entry = PackBase + GFX_PACK_HEADER_SIZE + i * GFX_PACK_ENTRY_SIZE;
+        U16 collId = gfxPackGet_U16LE(entry);
+        U16 w = gfxPackGet_U16LE(entry + 2);
+        U16 h = gfxPackGet_U16LE(entry + 4);
+        U32 offset = gfxPackGet_U32LE(entry + 8);
+        size_t size = (size_t) w * h;
+        struct Collection *coll;
+        MemRastPort *rp;
+
+        /* everything must fit into the pack */
+        if (offset > PackSize || size + GFX_PALETTE_SIZE > PackSize - offset) {
+            DebugMsg(ERR_WARNING, ERROR_MODULE_GFX, "pack: bad entry %u", i);
+            continue;
+        }
+
+        if (!(coll = gfxGetCollection(collId)) || coll->us_CollId != collId) {
+            DebugMsg(ERR_WARNING, ERROR_MODULE_GFX, "pack: unknown collection %u", collId);
+            continue;
+        }
+
+        /* a packed picture is a whole decoded screen, just like the ScratchRP */
+        if (w != SCREEN_WIDTH || h != SCREEN_HEIGHT
+            || coll->us_TotalWidth > w || coll->us_TotalHeight > h) {
+            DebugMsg(ERR_WARNING, ERROR_MODULE_GFX,
+                     "pack: collection %u has the wrong size", collId);
+            continue;
+        }
+
+        if (gfxPackIsStale(coll, entry)) {
+            DebugMsg(ERR_WARNING, ERROR_MODULE_GFX,
+                     "pack: collection %u has changed since the pack was built", collId);
+            continue;
+        }
+
+        rp = &PackRPs[packed++];
+
+        rp->w = w;
+        rp->h = h;
+        rp->collId = collId;
+
+        /* the mapping is read-only - packed pixels are only ever copied */
+        rp->pixels = PackBase + offset;
+        memcpy(rp->palette, PackBase + offset + size, GFX_PALETTE_SIZE);
+
+        coll->prepared = coll->packed = rp;
+    }
+
+    DebugMsg(ERR_DEBUG, ERROR_MODULE_GFX, "pack: %u collections from %s",
+             packed, pathname);
+}
+
+void gfxDoneCollPack(void)
+{
+    if (PackRPs) {
+        TCFreeMem(PackRPs, PackEntries * sizeof(*PackRPs));
+        PackRPs = NULL;
+        PackEntries = 0;
+    }
+
+    dskUnmap(PackBase, PackSize);
+    PackBase = NULL;
+    PackSize = 0;
+}
+
+static bool gfxPackWrite(FILE *fp, const void *src, size_t size)
+{
+    return fwrite(src, 1, size, fp) == size;
+}
+
+/*
+ * decodes every collection that is installed and writes them to the pack,
+ * the old pack is only replaced once the new one is complete (running
+ * instances keep their mapping of the old file)
+ *
+ * -p runs before the game is set up, so the result goes straight to
+ * stderr: DebugMsg hides it at the default level and its errors exit
+ * through tcDone
+ */
+bool gfxBuildCollPack(void)
+{
+    char pathname[DSK_PATH_MAX], packname[DSK_PATH_MAX], tmpname[DSK_PATH_MAX + 4];
+    const U32 pictSize = GFX_PACK_ALIGNED(SCREEN_SIZE + GFX_PALETTE_SIZE);
+    struct Collection *coll;
+    MemRastPort rp;
+    U32 i, count = 0, dirSize, offset;
+    U8 *dir;
+    FILE *fp;
+    bool ok = true;
+
+    gfxKernInit();
+    gfxInitCollList();
+
+    for (i = 1; (coll = gfxGetCollection(i)); i++) {
+        if (gfxCollPathName(coll, pathname))
+            count++;
+    }
+
+    if (!count) {
+        fprintf(stderr, "pack: no pictures found\n");
+        gfxDoneCollList();
+        return false;
+    }
+
+    dskBuildPathName(DISK_CHECK_DIR, PICTURE_DIRECTORY, GFX_PACK_NAME, packname);
+    snprintf(tmpname, sizeof(tmpname), "%s.tmp", packname);
+
+    if (!(fp = fopen(tmpname, "wb"))) {
+        fprintf(stderr, "pack: could not write %s\n", packname);
+        gfxDoneCollList();
+        return false;
+    }
+
+    /* header and directory */
+    dirSize = GFX_PACK_ALIGNED(GFX_PACK_HEADER_SIZE + count * GFX_PACK_ENTRY_SIZE);
+    dir = TCAllocMem(dirSize, true);
+
+    memcpy(dir, GFX_PACK_MAGIC, 4);
+    gfxPackPut_U32LE(dir + 4, GFX_PACK_VERSION);
+    gfxPackPut_U32LE(dir + 8, count);
+
+    offset = dirSize;
+    count = 0;
+
+    for (i = 1; (coll = gfxGetCollection(i)); i++) {
+        U8 *entry = dir + GFX_PACK_HEADER_SIZE + count * GFX_PACK_ENTRY_SIZE;
+
+        if (!gfxCollPathName(coll, pathname))
+            continue;
+
+        gfxPackPut_U16LE(entry, coll->us_CollId);
+        gfxPackPut_U16LE(entry + 2, SCREEN_WIDTH);
+        gfxPackPut_U16LE(entry + 4, SCREEN_HEIGHT);
+        gfxPackPut_U32LE(entry + 8, offset);
+        gfxPackPut_U32LE(entry + 12, (U32) dskFileLength(pathname));
+        gfxPackPut_U64LE(entry + 16, dskFileTime(pathname));
+
+        offset += pictSize;
+        count++;
+    }
+
+    ok = gfxPackWrite(fp, dir, dirSize);
+
+    /* pictures */
+    gfxInitMemRastPort(&rp, SCREEN_WIDTH, SCREEN_HEIGHT);
+
+    for (i = 1; ok && (coll = gfxGetCollection(i)); i++) {
+        static const U8 padding[GFX_PACK_ALIGN];
+
+        if (!gfxCollPathName(coll, pathname))
+            continue;
+
+        memset(rp.pixels, 0, SCREEN_SIZE);
+        gfxLoadILBMToRP(pathname, &rp);
+
+        ok = gfxPackWrite(fp, rp.pixels, SCREEN_SIZE)
+            && gfxPackWrite(fp, rp.palette, GFX_PALETTE_SIZE)
+            && gfxPackWrite(fp, padding, pictSize - SCREEN_SIZE - GFX_PALETTE_SIZE);
+    }
+
+    gfxDoneMemRastPort(&rp);
+    TCFreeMem(dir, dirSize);
+
+    if (fclose(fp) != 0)
+        ok = false;
+
+    if (ok) {
+        remove(packname);
+        ok = (rename(tmpname, packname) == 0);
+    } else {
+        remove(tmpname);
+    }
+
+    if (ok)
+        fprintf(stderr, "pack: wrote %u collections to %s\n", count, packname);
+    else
+        fprintf(stderr, "pack: could not write %s\n", packname);
+
+    gfxDoneCollList();
+    return ok;
+}
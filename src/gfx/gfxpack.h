@@ -0,0 +1,21 @@
+/****************************************************************************
+  Copyright (c) 2005 Vasco Alexandre da Silva Costa
+
+  Please read the license terms contained in the LICENSE and
+  publiclicensecontract.doc files which should be contained with this
+  distribution.
+ ****************************************************************************/
+
+#ifndef MODULE_GFXPACK
+#define MODULE_GFXPACK
+
+#include "theclou.h"
+
+#include "gfx/gfx.h"
+
+#define GFX_PACK_NAME           "pictures.pak"
+
+void gfxInitCollPack(void);
+void gfxDoneCollPack(void);
+
+#endif
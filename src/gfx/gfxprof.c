@@ -0,0 +1,150 @@
+/****************************************************************************
+  Copyright (c) 2005 Vasco Alexandre da Silva Costa
+
+  Please read the license terms contained in the LICENSE and
+  publiclicensecontract.doc files which should be contained with this
+  distribution.
+ ****************************************************************************/
+
+#include "base/base.h"
+
+#include "gfx/gfxprof.h"
+
+/*
+ * frame timing
+ *
+ * Timers add their raw performance counter ticks to a per frame counter
+ * (under a spinlock, the audio mixer runs on its own thread), so calls
+ * far shorter than a microsecond still add up. Once per frame
+ * gfxProfFrame takes the counters, converts them to microseconds and
+ * files them into histograms with log2 buckets: bucket 0 holds 0, bucket
+ * i holds [2^(i-1), 2^i) microseconds (or refreshes).
+ */
+
+#define GFX_PROF_BUCKETS    24
+
+typedef struct {
+    U32 frames;
+    U64 total;
+    U32 max;
+
+    U32 bucket[GFX_PROF_BUCKETS];
+} GfxProfHist;
+
+static const char *ProfNames[GFX_PROF_COUNT] = {
+    "animator",
+    "blit",
+    "convert",
+    "present",
+    "audio",
+    "sleep",
+    "frame",
+    "refreshes"
+};
+
+static U64 ProfCounter[GFX_PROF_COUNT];     /* ticks, or a count */
+static SDL_SpinLock ProfLock = 0;
+static GfxProfHist ProfHist[GFX_PROF_COUNT];
+
+static Uint64 ProfFreq = 0;
+static Uint64 ProfLastFrame = 0;
+
+Uint64 gfxProfStart(void)
+{
+    return SDL_GetPerformanceCounter();
+}
+
+static void gfxProfAddCounter(GfxProfE what, U64 value)
+{
+    SDL_LockSpinlock(&ProfLock);
+    ProfCounter[what] += value;
+    SDL_UnlockSpinlock(&ProfLock);
+}
+
+void gfxProfStop(GfxProfE what, Uint64 start)
+{
+    gfxProfAddCounter(what, SDL_GetPerformanceCounter() - start);
+}
+
+void gfxProfCount(GfxProfE what)
+{
+    gfxProfAddCounter(what, 1);
+}
+
+static void gfxProfAdd(GfxProfHist *hist, U32 value)
+{
+    unsigned b = 0;
+
+    while (b < GFX_PROF_BUCKETS - 1 && (value >> b))
+        b++;
+
+    hist->frames++;
+    hist->total += value;
+    hist->max = max(hist->max, value);
+
+    hist->bucket[b]++;
+}
+
+/* closes the current frame */
+void gfxProfFrame(void)
+{
+    Uint64 now = SDL_GetPerformanceCounter();
+    U64 counter[GFX_PROF_COUNT];
+    int i;
+
+    if (!ProfFreq)
+        ProfFreq = SDL_GetPerformanceFrequency();
+
+    if (ProfLastFrame)
+        gfxProfStop(GFX_PROF_FRAME, ProfLastFrame);
+
+    ProfLastFrame = now;
+
+    SDL_LockSpinlock(&ProfLock);
+    memcpy(counter, ProfCounter, sizeof(counter));
+    memset(ProfCounter, 0, sizeof(ProfCounter));
+    SDL_UnlockSpinlock(&ProfLock);
+
+    for (i = 0; i < GFX_PROF_COUNT; i++) {
+        U64 value = counter[i];
+
+        /* ticks to microseconds, refreshes are counted as they are */
+        if (i != GFX_PROF_REFRESHES)
+            value = value * 1000000 / ProfFreq;
+
+        gfxProfAdd(&ProfHist[i], (U32) min(value, UINT32_MAX));
+    }
+}
+
+/* writes one line per counter: totals, then the bucket counts */
+bool gfxProfDump(const char *fileName)
+{
+    FILE *fp;
+    int i, b;
+
+    if (!(fp = dskOpen(fileName, "w")))
+        return false;
+
+    fprintf(fp, "counter,frames,total,mean,max");
+    for (b = 0; b < GFX_PROF_BUCKETS - 1; b++)
+        fprintf(fp, ",<%" PRIu32, (U32) 1 << b);
+    fprintf(fp, ",>=%" PRIu32, (U32) 1 << (b - 1));
+    fprintf(fp, "\n");
+
+    for (i = 0; i < GFX_PROF_COUNT; i++) {
+        const GfxProfHist *hist = &ProfHist[i];
+
+        fprintf(fp, "%s,%" PRIu32 ",%" PRIu64 ",%" PRIu64 ",%" PRIu32,
+                ProfNames[i], hist->frames, hist->total,
+                hist->frames ? hist->total / hist->frames : 0, hist->max);
+
+        for (b = 0; b < GFX_PROF_BUCKETS; b++)
+            fprintf(fp, ",%" PRIu32, hist->bucket[b]);
+        fprintf(fp, "\n");
+    }
+
+    dskClose(fp);
+
+    DebugMsg(ERR_DEBUG, ERROR_MODULE_GFX, "frame timing written to %s", fileName);
+    return true;
+}
@@ -0,0 +1,38 @@
+/****************************************************************************
+  Copyright (c) 2005 Vasco Alexandre da Silva Costa
+
+  Please read the license terms contained in the LICENSE and
+  publiclicensecontract.doc files which should be contained with this
+  distribution.
+ ****************************************************************************/
+
+#ifndef MODULE_GFXPROF
+#define MODULE_GFXPROF
+
+#include "theclou.h"
+
+#include <SDL3/SDL.h>
+
+#define GFX_PROF_FILE_NAME      "timing.csv"
+
+typedef enum {
+    GFX_PROF_ANIMATOR,
+    GFX_PROF_BLIT,
+    GFX_PROF_CONVERT,
+    GFX_PROF_PRESENT,
+    GFX_PROF_AUDIO,             /* measured on the audio thread */
+    GFX_PROF_SLEEP,
+    GFX_PROF_FRAME,             /* from one gfxWaitTOF to the next */
+    GFX_PROF_REFRESHES,         /* a count, not a time */
+
+    GFX_PROF_COUNT
+} GfxProfE;
+
+Uint64 gfxProfStart(void);
+void gfxProfStop(GfxProfE what, Uint64 start);
+void gfxProfCount(GfxProfE what);
+
+void gfxProfFrame(void);
+bool gfxProfDump(const char *fileName);
+
+#endif
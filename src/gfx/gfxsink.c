@@ -0,0 +1,96 @@
+/****************************************************************************
+  Copyright (c) 2005 Vasco Alexandre da Silva Costa
+
+  Please read the license terms contained in the LICENSE and
+  publiclicensecontract.doc files which should be contained with this
+  distribution.
+ ****************************************************************************/
+
+#include "base/base.h"
+
+#include "gfx/gfxkern.h"
+#include "gfx/gfxsink.h"
+
+/*
+ * frame sink of the headless mode
+ *
+ * Instead of being presented, every frame is converted to XRGB and
+ * hashed (FNV-1a, chained over all frames), so a run can be compared
+ * against a known good one by its final hash. Optionally every n-th
+ * frame is written to frameNNNNNN.ppm as well.
+ */
+
+#define GFX_SINK_FNV_BASIS  UINT64_C(0xcbf29ce484222325)
+#define GFX_SINK_FNV_PRIME  UINT64_C(0x100000001b3)
+
+static U32 SinkFrame[SCREEN_SIZE];
+
+static U32 SinkFrames = 0;
+static U32 SinkDumpEvery = 0;
+static U64 SinkHash = GFX_SINK_FNV_BASIS;
+
+void gfxInitSink(unsigned dumpEvery)
+{
+    SinkFrames = 0;
+    SinkDumpEvery = dumpEvery;
+    SinkHash = GFX_SINK_FNV_BASIS;
+}
+
+void gfxDoneSink(void)
+{
+    printf("frames: %" PRIu32 " hash: %016" PRIx64 "\n", SinkFrames, SinkHash);
+}
+
+static void gfxSinkDump(const char *fileName)
+{
+    FILE *fp;
+    U8 rgb[SCREEN_WIDTH * 3];
+    int x, y;
+
+    if (!(fp = dskOpen(fileName, "wb")))
+        return;
+
+    fprintf(fp, "P6\n%d %d\n255\n", SCREEN_WIDTH, SCREEN_HEIGHT);
+
+    for (y = 0; y < SCREEN_HEIGHT; y++) {
+        const U32 *sp = &SinkFrame[y * SCREEN_WIDTH];
+
+        for (x = 0; x < SCREEN_WIDTH; x++) {
+            rgb[x * 3 + 0] = (U8) (sp[x] >> 16);
+            rgb[x * 3 + 1] = (U8) (sp[x] >> 8);
+            rgb[x * 3 + 2] = (U8) sp[x];
+        }
+
+        fwrite(rgb, 1, sizeof(rgb), fp);
+    }
+
+    dskClose(fp);
+}
+
+void gfxSinkFrame(const SDL_Surface *screen, const U32 *lut)
+{
+    const U8 *sp = screen->pixels;
+    size_t i;
+    int y;
+
+    for (y = 0; y < SCREEN_HEIGHT; y++, sp += screen->pitch)
+        gfxConvertRow(&SinkFrame[y * SCREEN_WIDTH], sp, SCREEN_WIDTH, lut);
+
+    /* hash the RGB value of every pixel (palette changes count too) */
+    for (i = 0; i < SCREEN_SIZE; i++) {
+        SinkHash = (SinkHash ^ (SinkFrame[i] & 0xff)) * GFX_SINK_FNV_PRIME;
+        SinkHash = (SinkHash ^ ((SinkFrame[i] >> 8) & 0xff)) * GFX_SINK_FNV_PRIME;
+        SinkHash = (SinkHash ^ ((SinkFrame[i] >> 16) & 0xff)) * GFX_SINK_FNV_PRIME;
+    }
+
+    SinkFrames++;
+
+    if (SinkDumpEvery && (SinkFrames % SinkDumpEvery) == 0) {
+        char fileName[32];
+
+        sprintf(fileName, "frame%06" PRIu32 ".ppm", SinkFrames);
+        gfxSinkDump(fileName);
+
+        printf("frame %" PRIu32 ": %016" PRIx64 "\n", SinkFrames, SinkHash);
+    }
+}
@@ -0,0 +1,21 @@
+/****************************************************************************
+  Copyright (c) 2005 Vasco Alexandre da Silva Costa
+
+  Please read the license terms contained in the LICENSE and
+  publiclicensecontract.doc files which should be contained with this
+  distribution.
+ ****************************************************************************/
+
+#ifndef MODULE_GFXSINK
+#define MODULE_GFXSINK
+
+#include "theclou.h"
+
+#include "gfx/gfx.h"
+
+void gfxInitSink(unsigned dumpEvery);
+void gfxDoneSink(void);
+
+void gfxSinkFrame(const SDL_Surface *screen, const U32 *lut);
+
+#endif
@@ -13,6 +13,8 @@
 
 #include <SDL3/SDL.h>
 
+#include "gfx/gfxprof.h"
+
 struct IHandler {
     S32 ul_XSensitivity;
     S32 ul_YSensitivity;
@@ -44,7 +46,10 @@ static void inpHandleQuitRequest(void)
 
 static void inpDoPseudoMultiTasking(void)
 {
+    Uint64 start = gfxProfStart();
+
     animator();
+    gfxProfStop(GFX_PROF_ANIMATOR, start);
 }
 
 void inpOpenAllInputDevs(void)
@@ -191,6 +196,10 @@ S32 inpWaitFor(S32 l_Mask)
 			    action |= INP_KEYBOARD + INP_FUNCTION_KEY;
 			break;
 
+		    case SDLK_F12:
+			gfxProfDump(GFX_PROF_FILE_NAME);
+			break;
+
 		    default:
 			break;
 		    }
@@ -38,8 +38,10 @@ void lsSetObjectRetrievalList(U32 ul_AreaId)
     S32 i;
 
     for (i = 0; i < 3; i++)
-	if (ul_AreaId == gLandscapeState->ul_ObjectRetrievalAreaId[i])
+	if (ul_AreaId == gLandscapeState->ul_ObjectRetrievalAreaId[i]) {
 	    gLandscapeState->p_ObjectRetrieval = gLandscapeState->p_ObjectRetrievalLists[i];
+	    gLandscapeState->p_ObjectIndex = gLandscapeState->p_ObjectIndexes[i];
+	}
 }
 
 U32 lsGetCurrObjectRetrieval(void)
@@ -215,6 +217,172 @@ uword lsGetFloorIndex(uword x, uword y)
     return (uword) (line * fpl + row);
 }
 
+/*
+ * The object index tells which objects are near a position without
+ * walking the whole retrieval list: each floor square has a bitmap of the
+ * objects whose exact size may touch it. Doors and windows change their
+ * exact size when they are turned, so objects are entered with both
+ * orientations and queries test the exact size of every candidate.
+ */
+#define LS_INDEX_SQUARES	(LS_FLOORS_PER_LINE * LS_FLOORS_PER_COLUMN)
+
+static void lsIndexRange(uword a0, uword a1, uword size, uword count,
+			 uword * first, uword * last)
+{
+    if (a0 > a1) {		/* coordinates wrapped around */
+	*first = 0;
+	*last = count - 1;
+    } else {
+	*first = min(a0 / size, count - 1);
+	*last = min(a1 / size, count - 1);
+    }
+}
+
+static void lsIndexObject(struct LSObjectIndex *index, U32 nr,
+			  uword x0, uword y0, uword x1, uword y1)
+{
+    uword col0, col1, row0, row1, col, row;
+
+    lsIndexRange(x0, x1, LS_FLOOR_X_SIZE, LS_FLOORS_PER_LINE, &col0, &col1);
+    lsIndexRange(y0, y1, LS_FLOOR_Y_SIZE, LS_FLOORS_PER_COLUMN, &row0, &row1);
+
+    for (row = row0; row <= row1; row++)
+	for (col = col0; col <= col1; col++)
+	    index->p_Squares[(row * LS_FLOORS_PER_LINE + col) * index->ul_Words
+			     + nr / 32] |= 1UL << (nr % 32);
+}
+
+struct LSObjectIndex *lsBuildObjectIndex(LIST *objects)
+{
+    struct LSObjectIndex *index = TCAllocMem(sizeof(*index), true);
+    struct ObjectNode *node;
+    U32 nr = 0;
+
+    index->ul_ObjectCount = GetNrOfNodes(objects);
+    index->ul_Words = (index->ul_ObjectCount + 31) / 32;
+
+    if (!index->ul_ObjectCount)
+	return index;
+
+    index->p_Objects =
+	TCAllocMem(index->ul_ObjectCount * sizeof(*index->p_Objects), true);
+    index->p_Squares =
+	TCAllocMem(LS_INDEX_SQUARES * index->ul_Words * sizeof(U32), true);
+
+    for (node = (struct ObjectNode *) LIST_HEAD(objects); NODE_SUCC((NODE *) node);
+	 node = (struct ObjectNode *) NODE_SUCC((NODE *) node), nr++) {
+	LSObject lso = OL_DATA(node);
+	Item item = dbGetObject(lso->Type);
+	uword x, y;
+
+	index->p_Objects[nr] = node;
+
+	/* same arithmetic as lsCalcExactSize */
+	x = lso->us_DestX + item->HExactXOffset;
+	y = lso->us_DestY + item->HExactYOffset;
+	lsIndexObject(index, nr, x, y, x + item->HExactWidth, y + item->HExactHeight);
+
+	x = lso->us_DestX + item->VExactXOffset;
+	y = lso->us_DestY + item->VExactYOffset;
+	lsIndexObject(index, nr, x, y, x + item->VExactWidth, y + item->VExactHeight);
+    }
+
+    return index;
+}
+
+void lsFreeObjectIndex(struct LSObjectIndex *index)
+{
+    if (!index)
+	return;
+
+    if (index->ul_ObjectCount) {
+	TCFreeMem(index->p_Objects, index->ul_ObjectCount * sizeof(*index->p_Objects));
+	TCFreeMem(index->p_Squares, LS_INDEX_SQUARES * index->ul_Words * sizeof(U32));
+    }
+
+    TCFreeMem(index, sizeof(*index));
+}
+
+void lsRebuildObjectIndex(U32 ul_AreaId)
+{
+    S32 i;
+
+    for (i = 0; i < 3; i++) {
+	if (ul_AreaId == gLandscapeState->ul_ObjectRetrievalAreaId[i]
+	    && gLandscapeState->p_ObjectRetrievalLists[i]) {
+	    lsFreeObjectIndex(gLandscapeState->p_ObjectIndexes[i]);
+	    gLandscapeState->p_ObjectIndexes[i] =
+		lsBuildObjectIndex(gLandscapeState->p_ObjectRetrievalLists[i]);
+
+	    if (gLandscapeState->p_ObjectRetrieval == gLandscapeState->p_ObjectRetrievalLists[i])
+		gLandscapeState->p_ObjectIndex = gLandscapeState->p_ObjectIndexes[i];
+	}
+    }
+}
+
+/* objects of the current retrieval list that overlap x0, y0 - x1, y1 (like lsIsInside) */
+void lsInitObjectQuery(struct LSObjectQuery *query, uword x0, uword y0, uword x1, uword y1)
+{
+    query->p_Index = gLandscapeState->p_ObjectIndex;
+
+    query->us_X0 = x0;
+    query->us_Y0 = y0;
+    query->us_X1 = x1;
+    query->us_Y1 = y1;
+
+    lsIndexRange(x0, x1, LS_FLOOR_X_SIZE, LS_FLOORS_PER_LINE,
+		 &query->us_Col0, &query->us_Col1);
+    lsIndexRange(y0, y1, LS_FLOOR_Y_SIZE, LS_FLOORS_PER_COLUMN,
+		 &query->us_Row0, &query->us_Row1);
+
+    query->ul_Word = 0;
+    query->ul_Bits = 0;
+}
+
+/*
+ * returns the next object of a query, in the order of the retrieval list,
+ * or NULL - queries neither allocate nor change the index, so they may be
+ * nested
+ */
+struct ObjectNode *lsNextObject(struct LSObjectQuery *query)
+{
+    struct LSObjectIndex *index = query->p_Index;
+
+    if (!index)
+	return NULL;
+
+    for (;;) {
+	struct ObjectNode *node;
+	LSObject lso;
+	U32 nr;
+
+	while (!query->ul_Bits) {
+	    uword col, row;
+
+	    if (query->ul_Word >= index->ul_Words)
+		return NULL;
+
+	    for (row = query->us_Row0; row <= query->us_Row1; row++)
+		for (col = query->us_Col0; col <= query->us_Col1; col++)
+		    query->ul_Bits |=
+			index->p_Squares[(row * LS_FLOORS_PER_LINE + col) * index->ul_Words
+					 + query->ul_Word];
+
+	    query->ul_Word++;
+	}
+
+	for (nr = 0; !(query->ul_Bits & (1UL << nr)); nr++);
+
+	query->ul_Bits &= query->ul_Bits - 1;
+
+	node = index->p_Objects[(query->ul_Word - 1) * 32 + nr];
+	lso = OL_DATA(node);
+
+	if (lsIsInside(lso, query->us_X0, query->us_Y0, query->us_X1, query->us_Y1))
+	    return node;
+    }
+}
+
 static void lsExtendGetList(LIST * list, U32 nr, U32 type, void *data)
 {
     struct ObjectNode *new =
@@ -228,21 +396,21 @@ static void lsExtendGetList(LIST * list, U32 nr, U32 type, void *data)
 LIST *lsGetObjectsByList(uword x, uword y, uword width, uword height,
 			 ubyte showInvisible, ubyte addLootBags)
 {
+    struct LSObjectQuery query;
     struct ObjectNode *node;
     LIST *list = CreateList();
     U32 i;
 
     /* diverse Objekte eintragen */
-    for (node = (struct ObjectNode *) LIST_HEAD(gLandscapeState->p_ObjectRetrieval);
-	 NODE_SUCC((NODE *) node);
-	 node = (struct ObjectNode *) NODE_SUCC((NODE *) node)) {
+    lsInitObjectQuery(&query, x, y, x + width, y + height);
+
+    while ((node = lsNextObject(&query))) {
 	LSObject lso = (LSObject) OL_DATA(node);
 
 	if ((lso->ul_Status & (1L << Const_tcACCESS_BIT))
 	    || (GamePlayMode & GP_LEVEL_DESIGN))
 	    if (showInvisible || lso->uch_Visible)
-		if (lsIsInside(lso, x, y, x + width, y + height))
-		    lsExtendGetList(list, OL_NR(node), lso->Type, lso);
+		lsExtendGetList(list, OL_NR(node), lso->Type, lso);
     }
 
     /* Ausnahme: Beutesack eintragen! */
@@ -317,3 +485,207 @@ LIST *lsGetRoomsOfArea(U32 ul_AreaId)
 
     return ObjectListPrivate;
 }
+
+/*
+ * room raster
+ *
+ * Answers whether two positions are inside the same room without walking
+ * the rooms. The edges of the rooms cut the area into columns and rows;
+ * every cell of them lies in the same set of rooms (rooms include their
+ * right and bottom edges, so neighbouring rooms overlap there). Each cell
+ * holds the number of its set and a table tells which sets share a room.
+ */
+struct LSRoomRaster {
+    U32 ul_Width, ul_Height;	/* of p_Col and p_Row */
+    uword us_Cols, us_Rows;
+
+    uword *p_Col;		/* column of every x */
+    uword *p_Row;		/* row of every y */
+    uword *p_Cells;		/* set of every cell, 0 is outside all rooms */
+
+    uword us_Sets;
+    ubyte *p_Shared;		/* us_Sets * us_Sets */
+};
+
+/* numbers the columns of a table, a new one starts at every edge */
+static uword lsInitRoomTable(uword * table, U32 size, const ubyte * edges)
+{
+    U32 i;
+    uword n = 0;
+
+    for (i = 0; i < size; i++) {
+	if (i && edges[i])
+	    n++;
+
+	table[i] = n;
+    }
+
+    return n + 1;
+}
+
+struct LSRoomRaster *lsBuildRoomRaster(LIST * rooms)
+{
+    struct LSRoomRaster *raster = TCAllocMem(sizeof(*raster), true);
+    U32 count = GetNrOfNodes(rooms), words = (count + 31) / 32;
+    U32 i, j, cells, sets, size;
+    U32 *masks, *setMasks;
+    ubyte *edges;
+    NODE *n;
+
+    if (!count)
+	return raster;
+
+    for (n = LIST_HEAD(rooms); NODE_SUCC(n); n = NODE_SUCC(n)) {
+	LSRoom room = OL_DATA(n);
+
+	raster->ul_Width = max(raster->ul_Width, (U32) room->us_LeftEdge + room->us_Width + 1);
+	raster->ul_Height = max(raster->ul_Height, (U32) room->us_TopEdge + room->us_Height + 1);
+    }
+
+    raster->p_Col = TCAllocMem(raster->ul_Width * sizeof(uword), true);
+    raster->p_Row = TCAllocMem(raster->ul_Height * sizeof(uword), true);
+
+    /* columns and rows */
+    size = max(raster->ul_Width, raster->ul_Height) + 1;
+    edges = TCAllocMem(size, true);
+
+    for (n = LIST_HEAD(rooms); NODE_SUCC(n); n = NODE_SUCC(n)) {
+	LSRoom room = OL_DATA(n);
+
+	edges[room->us_LeftEdge] = 1;
+	edges[(U32) room->us_LeftEdge + room->us_Width + 1] = 1;
+    }
+
+    raster->us_Cols = lsInitRoomTable(raster->p_Col, raster->ul_Width, edges);
+
+    memset(edges, 0, size);
+
+    for (n = LIST_HEAD(rooms); NODE_SUCC(n); n = NODE_SUCC(n)) {
+	LSRoom room = OL_DATA(n);
+
+	edges[room->us_TopEdge] = 1;
+	edges[(U32) room->us_TopEdge + room->us_Height + 1] = 1;
+    }
+
+    raster->us_Rows = lsInitRoomTable(raster->p_Row, raster->ul_Height, edges);
+
+    TCFreeMem(edges, size);
+
+    /* the rooms of every cell */
+    cells = (U32) raster->us_Cols * raster->us_Rows;
+    masks = TCAllocMem(cells * words * sizeof(U32), true);
+
+    for (n = LIST_HEAD(rooms), i = 0; NODE_SUCC(n); n = NODE_SUCC(n), i++) {
+	LSRoom room = OL_DATA(n);
+	uword col0 = raster->p_Col[room->us_LeftEdge];
+	uword col1 = raster->p_Col[(U32) room->us_LeftEdge + room->us_Width];
+	uword row0 = raster->p_Row[room->us_TopEdge];
+	uword row1 = raster->p_Row[(U32) room->us_TopEdge + room->us_Height];
+	uword col, row;
+
+	for (row = row0; row <= row1; row++)
+	    for (col = col0; col <= col1; col++)
+		masks[(row * raster->us_Cols + col) * words + i / 32] |= 1UL << (i % 32);
+    }
+
+    /* number the distinct sets of rooms, set 0 is the empty one */
+    raster->p_Cells = TCAllocMem(cells * sizeof(uword), true);
+    setMasks = TCAllocMem((cells + 1) * words * sizeof(U32), true);
+    sets = 1;
+
+    for (i = 0; i < cells; i++) {
+	U32 *mask = &masks[i * words];
+
+	for (j = 0; j < sets; j++)
+	    if (!memcmp(mask, &setMasks[j * words], words * sizeof(U32)))
+		break;
+
+	if (j == sets)
+	    memcpy(&setMasks[sets++ * words], mask, words * sizeof(U32));
+
+	raster->p_Cells[i] = (uword) j;
+    }
+
+    raster->us_Sets = (uword) sets;
+    raster->p_Shared = TCAllocMem(sets * sets, true);
+
+    for (i = 0; i < sets; i++)
+	for (j = 0; j < sets; j++) {
+	    U32 k;
+
+	    for (k = 0; k < words; k++)
+		if (setMasks[i * words + k] & setMasks[j * words + k])
+		    raster->p_Shared[i * sets + j] = 1;
+	}
+
+    TCFreeMem(setMasks, (cells + 1) * words * sizeof(U32));
+    TCFreeMem(masks, cells * words * sizeof(U32));
+
+    return raster;
+}
+
+void lsFreeRoomRaster(struct LSRoomRaster *raster)
+{
+    if (!raster)
+	return;
+
+    if (raster->us_Sets) {
+	TCFreeMem(raster->p_Col, raster->ul_Width * sizeof(uword));
+	TCFreeMem(raster->p_Row, raster->ul_Height * sizeof(uword));
+	TCFreeMem(raster->p_Cells, (U32) raster->us_Cols * raster->us_Rows * sizeof(uword));
+	TCFreeMem(raster->p_Shared, raster->us_Sets * raster->us_Sets);
+    }
+
+    TCFreeMem(raster, sizeof(*raster));
+}
+
+/*
+ * the room raster of an area of the building - built on first use and
+ * shared by everyone asking for it until lsDoneLandScape, NULL (no rooms)
+ * for areas of other buildings
+ */
+struct LSRoomRaster *lsGetRoomRaster(U32 ul_AreaId)
+{
+    S32 i;
+
+    for (i = 0; i < 3; i++) {
+	if (ul_AreaId == gLandscapeState->ul_ObjectRetrievalAreaId[i]
+	    && gLandscapeState->p_ObjectRetrievalLists[i]) {
+	    if (!gLandscapeState->p_RoomRasters[i]) {
+		LIST *rooms = lsGetRoomsOfArea(ul_AreaId);
+
+		gLandscapeState->p_RoomRasters[i] = lsBuildRoomRaster(rooms);
+		RemoveList(rooms);
+	    }
+
+	    return gLandscapeState->p_RoomRasters[i];
+	}
+    }
+
+    return NULL;
+}
+
+/* the set of rooms a position is in, see lsShareRoom */
+uword lsGetRoomSet(struct LSRoomRaster *raster, S32 x, S32 y)
+{
+    if (!raster || (x < 0) || (y < 0)
+	|| ((U32) x >= raster->ul_Width) || ((U32) y >= raster->ul_Height))
+	return 0;
+
+    return raster->p_Cells[raster->p_Row[y] * raster->us_Cols + raster->p_Col[x]];
+}
+
+/* do two sets of rooms have a room in common */
+bool lsShareRoom(struct LSRoomRaster *raster, uword set0, uword set1)
+{
+    if (!raster || !raster->us_Sets)	/* no rooms */
+	return false;
+
+    return raster->p_Shared[set0 * raster->us_Sets + set1];
+}
+
+/* are both positions inside the same room */
+bool lsInsideSameRoom(struct LSRoomRaster *raster, S32 x0, S32 y0, S32 x1, S32 y1)
+{
+    return lsShareRoom(raster, lsGetRoomSet(raster, x0, y0), lsGetRoomSet(raster, x1, y1));
+}
@@ -64,19 +64,20 @@ static void lsSetAlarmPict(LSObject lso)
 static void lsRefreshClosedDoors(uword us_X0, uword us_Y0,
                                  uword us_X1, uword us_Y1)
 {
-    NODE *node;
+    struct LSObjectQuery query;
+    struct ObjectNode *node;
 
     gLandscapeState->uch_ShowObjectMask = 0x40;
 
-    for (node = (NODE *) LIST_HEAD(gLandscapeState->p_ObjectRetrieval); NODE_SUCC(node);
-	 node = (NODE *) NODE_SUCC(node)) {
+    lsInitObjectQuery(&query, us_X0, us_Y0, us_X1, us_Y1);
+
+    while ((node = lsNextObject(&query))) {
 	LSObject lso = OL_DATA(node);
 
-	if (lsIsInside(lso, us_X0, us_Y0, us_X1, us_Y1))
-	    if (lsIsObjectADoor(lso))
-		if (lso->uch_Visible == LS_OBJECT_VISIBLE)
-		    lsShowOneObject(lso, LS_STD_COORDS, LS_STD_COORDS,
-				    LS_SHOW_DOOR);
+	if (lsIsObjectADoor(lso))
+	    if (lso->uch_Visible == LS_OBJECT_VISIBLE)
+		lsShowOneObject(lso, LS_STD_COORDS, LS_STD_COORDS,
+				LS_SHOW_DOOR);
     }
 
     gLandscapeState->uch_ShowObjectMask = 0x0;
@@ -256,11 +257,10 @@ void lsBlitOneObject(MemRastPort *rp, U16 offsetFact, U16 dx, U16 dy, U16 size)
 
 }
 
-S32 lsShowOneObject(LSObject lso, word destx, word desty, U32 ul_Mode)
+/* tells whether lsShowOneObject would display an object in this mode */
+S32 lsIsObjectShown(LSObject lso, U32 ul_Mode)
 {
-    Item item = dbGetObject(lso->Type);
     S32 show = 0;
-    uword offsetFact;
 
     switch (lso->Type) {
     case Item_Sockel:		/* pedestal should not be displayed */
@@ -291,27 +291,35 @@ S32 lsShowOneObject(LSObject lso, word destx, word desty, U32 ul_Mode)
 	if ((!show) && (ul_Mode & LS_SHOW_OTHER_1))
 	    if (lsIsObjectAnAddOn(lso) && lso->uch_Visible == LS_OBJECT_VISIBLE)
 		show = 1;
+	break;
+    }
+
+    return show;
+}
+
+S32 lsShowOneObject(LSObject lso, word destx, word desty, U32 ul_Mode)
+{
+    Item item = dbGetObject(lso->Type);
+    S32 show = lsIsObjectShown(lso, ul_Mode);
+    uword offsetFact;
+
+    if (show) {
+        MemRastPort *rp;
 
-	if (show) {
-            MemRastPort *rp;
-        
-            rp = lsPrepareFromMem(lso);
+        rp = lsPrepareFromMem(lso);
 
-	    offsetFact = item->OffsetFact + (lso->ul_Status & 3);
+	offsetFact = item->OffsetFact + (lso->ul_Status & 3);
 
-	    if (destx == LS_STD_COORDS)
-		destx = lso->us_DestX;
+	if (destx == LS_STD_COORDS)
+	    destx = lso->us_DestX;
 
-	    if (desty == LS_STD_COORDS)
-		desty = lso->us_DestY;
+	if (desty == LS_STD_COORDS)
+	    desty = lso->us_DestY;
 
-	    lsBlitOneObject(rp, offsetFact, destx, desty, item->Size);
-	}
-	break;
-    }
+	lsBlitOneObject(rp, offsetFact, destx, desty, item->Size);
 
-    if (show)
 	lsSetAlarmPict(lso);
+    }
 
     return show;
 }
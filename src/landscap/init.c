@@ -18,6 +18,8 @@
   distribution.
  ****************************************************************************/
 
+#include "base/base.h"
+
 #include "landscap/landscap.h"
 #include "landscap/landscap.ph"
 
@@ -86,6 +88,8 @@ void lsInitLandScape(U32 bID, ubyte mode)
 
     gLandscapeState->p_DoorRefreshList = CreateList();
 
+    lsInitBackgrounds();
+
     lsInitFloorSquares();
 
     lsInitActivArea(gLandscapeState->ul_AreaID, (uword) - 1, (uword) - 1, NULL);
@@ -99,6 +103,11 @@ void lsInitActivArea(U32 areaID, uword x, uword y, char *livingName)
     gLandscapeState->ul_AreaID = areaID;
 
     lsSetRelations(areaID);
+
+    /* the level designer moves objects */
+    if (GamePlayMode & GP_LEVEL_DESIGN)
+	lsRebuildObjectIndex(areaID);
+
     lsSetObjectRetrievalList(areaID);
 
     gLandscapeState->us_WindowXSize = area->us_Width;
@@ -163,6 +172,8 @@ void lsInitObjects(void)
     for (i = 0; i < 3; i++) {
 	gLandscapeState->ul_ObjectRetrievalAreaId[i] = 0;
 	gLandscapeState->p_ObjectRetrievalLists[i] = NULL;
+	gLandscapeState->p_ObjectIndexes[i] = NULL;
+	gLandscapeState->p_RoomRasters[i] = NULL;
     }
 
     for (n = (NODE *) LIST_HEAD(areas); NODE_SUCC(n); n = (NODE *) NODE_SUCC(n)) {
@@ -179,6 +190,7 @@ void lsInitObjects(void)
 
 	gLandscapeState->p_ObjectRetrievalLists[areaCount] = gLandscapeState->p_ObjectRetrieval;	/* und merken */
 	gLandscapeState->ul_ObjectRetrievalAreaId[areaCount] = OL_NR(n);
+	gLandscapeState->p_ObjectIndexes[areaCount] = gLandscapeState->p_ObjectIndex;
 
 	areaCount++;
     }
@@ -365,6 +377,10 @@ void lsDoneLandScape(void)
 	    if (gLandscapeState->p_ObjectRetrievalLists[areaCount]) {
 		RemoveList(gLandscapeState->p_ObjectRetrievalLists[areaCount]);
 		gLandscapeState->p_ObjectRetrievalLists[areaCount] = NULL;
+		lsFreeObjectIndex(gLandscapeState->p_ObjectIndexes[areaCount]);
+		gLandscapeState->p_ObjectIndexes[areaCount] = NULL;
+		lsFreeRoomRaster(gLandscapeState->p_RoomRasters[areaCount]);
+		gLandscapeState->p_RoomRasters[areaCount] = NULL;
 		gLandscapeState->ul_ObjectRetrievalAreaId[areaCount] = 0;
 	    }
 	}
@@ -382,6 +398,7 @@ void lsDoneLandScape(void)
 	}
 
 	BobDone(gLandscapeState->us_EscapeCarBobId);
+	BobDoneLists();
 
 	lsDoneSpots();
 
@@ -392,6 +409,8 @@ void lsDoneLandScape(void)
 	if (gLandscapeState->p_DoorRefreshList)
 	    RemoveList(gLandscapeState->p_DoorRefreshList);
 
+	lsDoneBackgrounds();
+
 	TCFreeMem(gLandscapeState, sizeof(*gLandscapeState));
 	gLandscapeState = NULL;
     }
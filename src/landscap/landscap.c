@@ -94,28 +94,193 @@ static void lsShowRooms(void)
 }
 #endif
 
+/*
+ * background cache
+ *
+ * Floors and objects up to the doors only depend on the area and on the
+ * position and state of its objects. Once built they are kept per area,
+ * so entering the area again (e.g. when switching to another member of
+ * the crew) just copies them back as long as no object changed in
+ * between - the level designer moves objects in place, for example.
+ */
+
+#define LS_BACKGROUND_SIZE	(LS_MAX_AREA_WIDTH * LS_MAX_AREA_HEIGHT)
+
+/* id, position and draw state of each object */
+#define LS_BG_OBJECT_WORDS	3
+
+/* everything about an object that changes how it is drawn */
+static U32 lsGetDrawState(LSObject lso)
+{
+    return (U32) lso->uch_Visible | ((lso->ul_Status & 3) << 8) |
+	((U32) (lso->uch_Chained & Const_tcCHAINED_TO_ALARM) << 16);
+}
+
+static U32 lsGetDrawPos(LSObject lso)
+{
+    return ((U32) lso->us_DestX << 16) | lso->us_DestY;
+}
+
+void lsInitBackgrounds(void)
+{
+    S32 i;
+
+    for (i = 0; i < 3; i++)
+	gLandscapeState->p_Backgrounds[i] = NULL;
+}
+
+void lsDoneBackgrounds(void)
+{
+    S32 i;
+
+    for (i = 0; i < 3; i++) {
+	struct LSBackground *bg = gLandscapeState->p_Backgrounds[i];
+
+	if (bg) {
+	    TCFreeMem(bg->p_Pixels, LS_BACKGROUND_SIZE);
+	    TCFreeMem(bg->p_ObjectState, bg->ul_ObjectCount * LS_BG_OBJECT_WORDS * sizeof(U32));
+	    TCFreeMem(bg, sizeof(*bg));
+
+	    gLandscapeState->p_Backgrounds[i] = NULL;
+	}
+    }
+}
+
+/*
+ * the backgrounds are kept in order of their last use, so when all slots
+ * are taken the last one is the one to replace
+ */
+static void lsUseBackground(S32 slot)
+{
+    struct LSBackground *bg = gLandscapeState->p_Backgrounds[slot];
+
+    for (; slot > 0; slot--)
+	gLandscapeState->p_Backgrounds[slot] = gLandscapeState->p_Backgrounds[slot - 1];
+
+    gLandscapeState->p_Backgrounds[0] = bg;
+}
+
+static struct LSBackground *lsGetBackground(U32 areaId)
+{
+    S32 i;
+
+    for (i = 0; i < 3; i++) {
+	struct LSBackground *bg = gLandscapeState->p_Backgrounds[i];
+
+	if (bg && bg->ul_AreaId == areaId) {
+	    lsUseBackground(i);
+	    return bg;
+	}
+    }
+
+    return NULL;
+}
+
+static ubyte lsIsBackgroundValid(struct LSBackground *bg)
+{
+    NODE *node;
+    U32 i = 0;
+
+    if (bg->ul_ObjectCount != lsGetObjectCount())
+	return 0;
+
+    for (node = (NODE *) LIST_HEAD(gLandscapeState->p_ObjectRetrieval); NODE_SUCC(node);
+	 node = (NODE *) NODE_SUCC(node), i++) {
+	U32 *state = &bg->p_ObjectState[i * LS_BG_OBJECT_WORDS];
+
+	if (state[0] != OL_NR(node)
+	    || state[1] != lsGetDrawPos(OL_DATA(node))
+	    || state[2] != lsGetDrawState(OL_DATA(node)))
+	    return 0;
+    }
+
+    return 1;
+}
+
+static void lsSaveBackground(U32 areaId)
+{
+    struct LSBackground *bg = lsGetBackground(areaId);
+    U32 count = lsGetObjectCount(), i = 0;
+    NODE *node;
+
+    if (!bg) {
+	S32 slot;
+
+	/* a free slot or else the least recently used one */
+	for (slot = 0; slot < 2 && gLandscapeState->p_Backgrounds[slot]; slot++);
+
+	if (!(bg = gLandscapeState->p_Backgrounds[slot])) {
+	    bg = TCAllocMem(sizeof(*bg), true);
+	    bg->p_Pixels = TCAllocMem(LS_BACKGROUND_SIZE, false);
+
+	    gLandscapeState->p_Backgrounds[slot] = bg;
+	}
+
+	bg->ul_AreaId = areaId;
+
+	lsUseBackground(slot);
+    }
+
+    if (bg->ul_ObjectCount != count) {
+	TCFreeMem(bg->p_ObjectState,
+		  bg->ul_ObjectCount * LS_BG_OBJECT_WORDS * sizeof(U32));
+
+	bg->p_ObjectState =
+	    count ? TCAllocMem(count * LS_BG_OBJECT_WORDS * sizeof(U32), false) : NULL;
+	bg->ul_ObjectCount = count;
+    }
+
+    for (node = (NODE *) LIST_HEAD(gLandscapeState->p_ObjectRetrieval); NODE_SUCC(node);
+	 node = (NODE *) NODE_SUCC(node), i++) {
+	U32 *state = &bg->p_ObjectState[i * LS_BG_OBJECT_WORDS];
+
+	state[0] = OL_NR(node);
+	state[1] = lsGetDrawPos(OL_DATA(node));
+	state[2] = lsGetDrawState(OL_DATA(node));
+    }
+
+    memcpy(bg->p_Pixels, LSRPInMem.pixels, LS_BACKGROUND_SIZE);
+}
+
+/* shows an object while the background is built, or only tells if it would */
+static S32 lsBuildObject(LSObject lso, U32 ul_Mode, ubyte draw)
+{
+    if (draw)
+	return lsShowOneObject(lso, LS_STD_COORDS, LS_STD_COORDS, ul_Mode);
+
+    return lsIsObjectShown(lso, ul_Mode);
+}
+
 void lsBuildScrollWindow(void)
 {
     S32 i, j;
     NODE *node;
     LSArea area = (LSArea) dbGetObject(gLandscapeState->ul_AreaID);
+    struct LSBackground *bg = lsGetBackground(gLandscapeState->ul_AreaID);
+    ubyte draw = !(bg && lsIsBackgroundValid(bg));
     U8 palette[GFX_PALETTE_SIZE];
 
     gfxSetColorRange(0, 255);
     gfxChangeColors(u_gc, 0, GFX_FADE_OUT, 0);
 
-    /* Boden aufbauen */
-    for (i = 0; i < LS_FLOORS_PER_COLUMN; i++) {
-	for (j = 0; j < LS_FLOORS_PER_LINE; j++) {
-	    /* if no floor is available fill with collision colour */
-
-	    if (LS_NO_FLOOR
-		((gLandscapeState->p_CurrFloor[i * LS_FLOORS_PER_LINE + j].uch_FloorType))) {
-		lsSafeRectFill(j * 32, i * 32, j * 32 + 31, i * 32 + 31,
-                    LS_COLLIS_COLOR_2);
-	    } else
-		lsBlitFloor((i * LS_FLOORS_PER_LINE + j), j * 32, i * 32);
+    if (draw) {
+	/* Boden aufbauen */
+	for (i = 0; i < LS_FLOORS_PER_COLUMN; i++) {
+	    for (j = 0; j < LS_FLOORS_PER_LINE; j++) {
+		/* if no floor is available fill with collision colour */
+
+		if (LS_NO_FLOOR
+		    ((gLandscapeState->p_CurrFloor[i * LS_FLOORS_PER_LINE + j].uch_FloorType))) {
+		    lsSafeRectFill(j * 32, i * 32, j * 32 + 31, i * 32 + 31,
+			LS_COLLIS_COLOR_2);
+		} else
+		    lsBlitFloor((i * LS_FLOORS_PER_LINE + j), j * 32, i * 32);
+	    }
 	}
+    } else {
+	/* the objects are only checked, they are already in the background */
+	memcpy(LSRPInMem.pixels, bg->p_Pixels, LS_BACKGROUND_SIZE);
+	gfxLSMarkChanged(0, 0, LS_MAX_AREA_WIDTH, LS_MAX_AREA_HEIGHT);
     }
 
     /* Objekte setzen - zuerst Wände */
@@ -123,7 +288,7 @@ void lsBuildScrollWindow(void)
 	 node = (NODE *) NODE_SUCC(node)) {
 	LSObject lso = OL_DATA(node);
 
-	if (lsShowOneObject(lso, LS_STD_COORDS, LS_STD_COORDS, LS_SHOW_WALL))
+	if (lsBuildObject(lso, LS_SHOW_WALL, draw))
 	    lsTurnObject(lso, lso->uch_Visible, LS_COLLISION);
 
     }
@@ -133,7 +298,7 @@ void lsBuildScrollWindow(void)
 	 node = (NODE *) NODE_SUCC(node)) {
 	LSObject lso = OL_DATA(node);
 
-	if (lsShowOneObject(lso, LS_STD_COORDS, LS_STD_COORDS, LS_SHOW_OTHER_0))
+	if (lsBuildObject(lso, LS_SHOW_OTHER_0, draw))
 	    lsTurnObject(lso, lso->uch_Visible, LS_COLLISION);
     }
 
@@ -142,15 +307,19 @@ void lsBuildScrollWindow(void)
 	 node = (NODE *) NODE_SUCC(node)) {
 	LSObject lso = OL_DATA(node);
 
-	if (lsShowOneObject(lso, LS_STD_COORDS, LS_STD_COORDS, LS_SHOW_OTHER_1))
+	if (lsBuildObject(lso, LS_SHOW_OTHER_1, draw))
 	    lsTurnObject(lso, lso->uch_Visible, LS_COLLISION);
 
 	/* because of the dirty hack statues need to be refreshed specially */
-	if (lso->Type == Item_Statue)
+	if (draw && lso->Type == Item_Statue)
 	    if (lso->uch_Visible != LS_OBJECT_VISIBLE)
 		lsRefreshStatue(lso);
     }
 
+    /* doors are taken from here on, so this is the background to keep */
+    if (draw)
+	lsSaveBackground(gLandscapeState->ul_AreaID);
+
     /* now refresh all doors and special objects */
     for (node = (NODE *) LIST_HEAD(gLandscapeState->p_ObjectRetrieval); NODE_SUCC(node);
 	 node = (NODE *) NODE_SUCC(node)) {
@@ -362,6 +531,8 @@ void lsRefreshObjectList(U32 areaID)
     gLandscapeState->p_ObjectRetrieval = ObjectListPrivate;
 
     lsSortObjectList(&gLandscapeState->p_ObjectRetrieval);
+
+    gLandscapeState->p_ObjectIndex = lsBuildObjectIndex(gLandscapeState->p_ObjectRetrieval);
 }
 
 U32 lsAddLootBag(uword x, uword y, ubyte bagNr)
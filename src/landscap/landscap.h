@@ -96,6 +96,14 @@
 #define   LS_NO_COLLISION     		0
 #define   LS_COLLISION        		1
 
+#define	LS_COLLIS_COLOR_0		  		1
+#define	LS_COLLIS_COLOR_1		 		65
+#define  LS_COLLIS_COLOR_2				0
+#define  LS_COLLIS_COLOR_3				64
+
+#define   LS_IS_COLLIS_COLOR(c)	(((c) == LS_COLLIS_COLOR_0) || ((c) == LS_COLLIS_COLOR_1) \
+				 || ((c) == LS_COLLIS_COLOR_2) || ((c) == LS_COLLIS_COLOR_3))
+
 
 #define   LS_MAX_AREA_WIDTH        640
 #define   LS_MAX_AREA_HEIGHT       256	/* so that wall fits, also in the last line */
@@ -154,6 +162,16 @@ extern void lsSetCollMode(ubyte collMode);
 
 extern LIST *lsGetRoomsOfArea(U32 ul_AreaId);
 
+struct LSRoomRaster;
+
+extern struct LSRoomRaster *lsBuildRoomRaster(LIST * rooms);
+extern void lsFreeRoomRaster(struct LSRoomRaster *raster);
+extern struct LSRoomRaster *lsGetRoomRaster(U32 ul_AreaId);
+extern bool lsInsideSameRoom(struct LSRoomRaster *raster, S32 x0, S32 y0,
+			     S32 x1, S32 y1);
+extern uword lsGetRoomSet(struct LSRoomRaster *raster, S32 x, S32 y);
+extern bool lsShareRoom(struct LSRoomRaster *raster, uword set0, uword set1);
+
 extern void lsSetObjectRetrievalList(U32 ul_AreaId);
 extern U32 lsGetCurrObjectRetrieval(void);
 
@@ -228,6 +246,7 @@ extern void lsShowAlarmAndPower(LSObject lso, U32 x, U32 y);
 
 extern S32 lsShowOneObject(LSObject lso, word destx, word desty,
 			   U32 ObjTypeFilter);
+extern S32 lsIsObjectShown(LSObject lso, U32 ObjTypeFilter);
 
 void  lsSafeRectFill(U16 x0, U16 y0, U16 x1, U16 y1, U8 color);
 
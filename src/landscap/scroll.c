@@ -170,8 +170,9 @@ ubyte lsIsCollision(S32 x, S32 y, ubyte direction)
 	return collis;
 
 
+    /* color[i] is set when the pixel has a collision colour */
     for (i = 0; i < 14; i++)
-	color[i] = 255;
+	color[i] = 0;
 
     /* check collision
        As the Maxi always moves by 2 pixels, pixels must be checked
@@ -180,155 +181,155 @@ ubyte lsIsCollision(S32 x, S32 y, ubyte direction)
     switch (direction) {
 	/*
 	   case LS_SCROLL_LEFT:
-	   color[0] = gfxLSReadPixel(x - 2, y - 2);
-	   color[1] = gfxLSReadPixel(x - 2, y + 0);
-	   color[2] = gfxLSReadPixel(x - 2, y + 2);
-	   color[3] = gfxLSReadPixel(x - 2, y + 4);
-	   color[4] = gfxLSReadPixel(x - 2, y + 6);
-	   color[5] = gfxLSReadPixel(x - 2, y + 8);
-	   color[6] = gfxLSReadPixel(x - 2, y + 10);
-
-	   color[7] = gfxLSReadPixel(x - 1, y - 2);
-	   color[8] = gfxLSReadPixel(x - 1, y + 0);
-	   color[9] = gfxLSReadPixel(x - 1, y + 2);
-	   color[10] = gfxLSReadPixel( x - 1, y + 4);
-	   color[11] = gfxLSReadPixel( x - 1, y + 6);
-	   color[12] = gfxLSReadPixel( x - 1, y + 8);
-	   color[13] = gfxLSReadPixel( x - 1, y + 10);
+	   color[0] = gfxLSIsCollis(x - 2, y - 2);
+	   color[1] = gfxLSIsCollis(x - 2, y + 0);
+	   color[2] = gfxLSIsCollis(x - 2, y + 2);
+	   color[3] = gfxLSIsCollis(x - 2, y + 4);
+	   color[4] = gfxLSIsCollis(x - 2, y + 6);
+	   color[5] = gfxLSIsCollis(x - 2, y + 8);
+	   color[6] = gfxLSIsCollis(x - 2, y + 10);
+
+	   color[7] = gfxLSIsCollis(x - 1, y - 2);
+	   color[8] = gfxLSIsCollis(x - 1, y + 0);
+	   color[9] = gfxLSIsCollis(x - 1, y + 2);
+	   color[10] = gfxLSIsCollis( x - 1, y + 4);
+	   color[11] = gfxLSIsCollis( x - 1, y + 6);
+	   color[12] = gfxLSIsCollis( x - 1, y + 8);
+	   color[13] = gfxLSIsCollis( x - 1, y + 10);
 
 	   collisDir |= LS_COLLIS_LEFT;
 	   break;
 	   case LS_SCROLL_RIGHT:
-	   color[0] = gfxLSReadPixel(x + 16, y - 2);
-	   color[1] = gfxLSReadPixel(x + 16, y + 0);
-	   color[2] = gfxLSReadPixel(x + 16, y + 2);
-	   color[3] = gfxLSReadPixel(x + 16, y + 4);
-	   color[4] = gfxLSReadPixel(x + 16, y + 6);
-	   color[5] = gfxLSReadPixel(x + 16, y + 8);
-	   color[6] = gfxLSReadPixel(x + 16, y + 10);
-
-	   color[7] = gfxLSReadPixel(x + 17, y - 2);
-	   color[8] = gfxLSReadPixel(x + 17, y + 0);
-	   color[9] = gfxLSReadPixel(x + 17, y + 2);
-	   color[10] = gfxLSReadPixel(x + 17, y + 4);
-	   color[11] = gfxLSReadPixel(x + 17, y + 6);
-	   color[12] = gfxLSReadPixel(x + 17, y + 8);
-	   color[13] = gfxLSReadPixel(x + 17, y + 10);
+	   color[0] = gfxLSIsCollis(x + 16, y - 2);
+	   color[1] = gfxLSIsCollis(x + 16, y + 0);
+	   color[2] = gfxLSIsCollis(x + 16, y + 2);
+	   color[3] = gfxLSIsCollis(x + 16, y + 4);
+	   color[4] = gfxLSIsCollis(x + 16, y + 6);
+	   color[5] = gfxLSIsCollis(x + 16, y + 8);
+	   color[6] = gfxLSIsCollis(x + 16, y + 10);
+
+	   color[7] = gfxLSIsCollis(x + 17, y - 2);
+	   color[8] = gfxLSIsCollis(x + 17, y + 0);
+	   color[9] = gfxLSIsCollis(x + 17, y + 2);
+	   color[10] = gfxLSIsCollis(x + 17, y + 4);
+	   color[11] = gfxLSIsCollis(x + 17, y + 6);
+	   color[12] = gfxLSIsCollis(x + 17, y + 8);
+	   color[13] = gfxLSIsCollis(x + 17, y + 10);
 
 	   collisDir |= LS_COLLIS_RIGHT;
 	   break;
 	   case LS_SCROLL_UP:
-	   color[0] = gfxLSReadPixel(x + 1 , y - 3);
-	   color[1] = gfxLSReadPixel(x + 2 , y - 3);
-	   color[2] = gfxLSReadPixel(x + 4 , y - 3);
-	   color[3] = gfxLSReadPixel(x + 6 , y - 3);
-	   color[4] = gfxLSReadPixel(x + 9 , y - 3);
-	   color[5] = gfxLSReadPixel(x + 12, y - 3);
-	   color[6] = gfxLSReadPixel(x + 14, y - 3);
-
-	   color[7] = gfxLSReadPixel(x + 1 , y - 4);
-	   color[8] = gfxLSReadPixel(x + 2 , y - 4);
-	   color[9] = gfxLSReadPixel(x + 4 , y - 4);
-	   color[10] = gfxLSReadPixel(x + 6 , y - 4);
-	   color[11] = gfxLSReadPixel(x + 9 , y - 4);
-	   color[12] = gfxLSReadPixel(x + 12, y - 4);
-	   color[13] = gfxLSReadPixel(x + 14, y - 4);
+	   color[0] = gfxLSIsCollis(x + 1 , y - 3);
+	   color[1] = gfxLSIsCollis(x + 2 , y - 3);
+	   color[2] = gfxLSIsCollis(x + 4 , y - 3);
+	   color[3] = gfxLSIsCollis(x + 6 , y - 3);
+	   color[4] = gfxLSIsCollis(x + 9 , y - 3);
+	   color[5] = gfxLSIsCollis(x + 12, y - 3);
+	   color[6] = gfxLSIsCollis(x + 14, y - 3);
+
+	   color[7] = gfxLSIsCollis(x + 1 , y - 4);
+	   color[8] = gfxLSIsCollis(x + 2 , y - 4);
+	   color[9] = gfxLSIsCollis(x + 4 , y - 4);
+	   color[10] = gfxLSIsCollis(x + 6 , y - 4);
+	   color[11] = gfxLSIsCollis(x + 9 , y - 4);
+	   color[12] = gfxLSIsCollis(x + 12, y - 4);
+	   color[13] = gfxLSIsCollis(x + 14, y - 4);
 	   collisDir |= LS_COLLIS_UP;
 	   break;
 	   case LS_SCROLL_DOWN:
-	   color[0] = gfxLSReadPixel(x + 1 , y + 13);
-	   color[1] = gfxLSReadPixel(x + 2 , y + 13);
-	   color[2] = gfxLSReadPixel(x + 4 , y + 13);
-	   color[3] = gfxLSReadPixel(x + 6 , y + 13);
-	   color[4] = gfxLSReadPixel(x + 9 , y + 13);
-	   color[5] = gfxLSReadPixel(x + 12, y + 13);
-	   color[6] = gfxLSReadPixel(x + 14, y + 13);
-
-	   color[7] = gfxLSReadPixel(x + 1 , y + 14);
-	   color[8] = gfxLSReadPixel(x + 2 , y + 14);
-	   color[9] = gfxLSReadPixel(x + 4 , y + 14);
-	   color[10] = gfxLSReadPixel(x + 6 , y + 14);
-	   color[11] = gfxLSReadPixel(x + 9 , y + 14);
-	   color[12] = gfxLSReadPixel(x + 12, y + 14);
-	   color[13] = gfxLSReadPixel(x + 14, y + 14);
+	   color[0] = gfxLSIsCollis(x + 1 , y + 13);
+	   color[1] = gfxLSIsCollis(x + 2 , y + 13);
+	   color[2] = gfxLSIsCollis(x + 4 , y + 13);
+	   color[3] = gfxLSIsCollis(x + 6 , y + 13);
+	   color[4] = gfxLSIsCollis(x + 9 , y + 13);
+	   color[5] = gfxLSIsCollis(x + 12, y + 13);
+	   color[6] = gfxLSIsCollis(x + 14, y + 13);
+
+	   color[7] = gfxLSIsCollis(x + 1 , y + 14);
+	   color[8] = gfxLSIsCollis(x + 2 , y + 14);
+	   color[9] = gfxLSIsCollis(x + 4 , y + 14);
+	   color[10] = gfxLSIsCollis(x + 6 , y + 14);
+	   color[11] = gfxLSIsCollis(x + 9 , y + 14);
+	   color[12] = gfxLSIsCollis(x + 12, y + 14);
+	   color[13] = gfxLSIsCollis(x + 14, y + 14);
 
 	   collisDir |= LS_COLLIS_DOWN;
 	   break;
 	 */
 
     case LS_SCROLL_LEFT:
-	color[0] = gfxLSReadPixel(x - 2, y - 2);
-	color[1] = gfxLSReadPixel(x - 2, y + 0);
-	color[2] = gfxLSReadPixel(x - 2, y + 2);
-	color[3] = gfxLSReadPixel(x - 2, y + 4);
-	color[4] = gfxLSReadPixel(x - 2, y + 6);
-	color[5] = gfxLSReadPixel(x - 2, y + 8);
-	color[6] = gfxLSReadPixel(x - 2, y + 10);
-
-	color[7] = gfxLSReadPixel(x - 1, y - 2);
-	color[8] = gfxLSReadPixel(x - 1, y + 0);
-	color[9] = gfxLSReadPixel(x - 1, y + 2);
-	color[10] = gfxLSReadPixel(x - 1, y + 4);
-	color[11] = gfxLSReadPixel(x - 1, y + 6);
-	color[12] = gfxLSReadPixel(x - 1, y + 8);
-	color[13] = gfxLSReadPixel(x - 1, y + 10);
+	color[0] = gfxLSIsCollis(x - 2, y - 2);
+	color[1] = gfxLSIsCollis(x - 2, y + 0);
+	color[2] = gfxLSIsCollis(x - 2, y + 2);
+	color[3] = gfxLSIsCollis(x - 2, y + 4);
+	color[4] = gfxLSIsCollis(x - 2, y + 6);
+	color[5] = gfxLSIsCollis(x - 2, y + 8);
+	color[6] = gfxLSIsCollis(x - 2, y + 10);
+
+	color[7] = gfxLSIsCollis(x - 1, y - 2);
+	color[8] = gfxLSIsCollis(x - 1, y + 0);
+	color[9] = gfxLSIsCollis(x - 1, y + 2);
+	color[10] = gfxLSIsCollis(x - 1, y + 4);
+	color[11] = gfxLSIsCollis(x - 1, y + 6);
+	color[12] = gfxLSIsCollis(x - 1, y + 8);
+	color[13] = gfxLSIsCollis(x - 1, y + 10);
 
 	collisDir |= LS_COLLIS_LEFT;
 	break;
     case LS_SCROLL_RIGHT:
-	color[0] = gfxLSReadPixel(x + 16, y - 2);
-	color[1] = gfxLSReadPixel(x + 16, y + 0);
-	color[2] = gfxLSReadPixel(x + 16, y + 2);
-	color[3] = gfxLSReadPixel(x + 16, y + 4);
-	color[4] = gfxLSReadPixel(x + 16, y + 6);
-	color[5] = gfxLSReadPixel(x + 16, y + 8);
-	color[6] = gfxLSReadPixel(x + 16, y + 10);
-
-	color[7] = gfxLSReadPixel(x + 17, y - 2);
-	color[8] = gfxLSReadPixel(x + 17, y + 0);
-	color[9] = gfxLSReadPixel(x + 17, y + 2);
-	color[10] = gfxLSReadPixel(x + 17, y + 4);
-	color[11] = gfxLSReadPixel(x + 17, y + 6);
-	color[12] = gfxLSReadPixel(x + 17, y + 8);
-	color[13] = gfxLSReadPixel(x + 17, y + 10);
+	color[0] = gfxLSIsCollis(x + 16, y - 2);
+	color[1] = gfxLSIsCollis(x + 16, y + 0);
+	color[2] = gfxLSIsCollis(x + 16, y + 2);
+	color[3] = gfxLSIsCollis(x + 16, y + 4);
+	color[4] = gfxLSIsCollis(x + 16, y + 6);
+	color[5] = gfxLSIsCollis(x + 16, y + 8);
+	color[6] = gfxLSIsCollis(x + 16, y + 10);
+
+	color[7] = gfxLSIsCollis(x + 17, y - 2);
+	color[8] = gfxLSIsCollis(x + 17, y + 0);
+	color[9] = gfxLSIsCollis(x + 17, y + 2);
+	color[10] = gfxLSIsCollis(x + 17, y + 4);
+	color[11] = gfxLSIsCollis(x + 17, y + 6);
+	color[12] = gfxLSIsCollis(x + 17, y + 8);
+	color[13] = gfxLSIsCollis(x + 17, y + 10);
 
 	collisDir |= LS_COLLIS_RIGHT;
 	break;
     case LS_SCROLL_UP:
-	color[0] = gfxLSReadPixel(x + 3, y - 3);
-	color[1] = gfxLSReadPixel(x + 3, y - 3);
-	color[2] = gfxLSReadPixel(x + 4, y - 3);
-	color[3] = gfxLSReadPixel(x + 6, y - 3);
-	color[4] = gfxLSReadPixel(x + 9, y - 3);
-	color[5] = gfxLSReadPixel(x + 11, y - 3);
-	color[6] = gfxLSReadPixel(x + 11, y - 3);
-
-	color[7] = gfxLSReadPixel(x + 3, y - 4);
-	color[8] = gfxLSReadPixel(x + 3, y - 4);
-	color[9] = gfxLSReadPixel(x + 4, y - 4);
-	color[10] = gfxLSReadPixel( x + 6, y - 4);
-	color[11] = gfxLSReadPixel( x + 9, y - 4);
-	color[12] = gfxLSReadPixel( x + 11, y - 4);
-	color[13] = gfxLSReadPixel( x + 11, y - 4);
+	color[0] = gfxLSIsCollis(x + 3, y - 3);
+	color[1] = gfxLSIsCollis(x + 3, y - 3);
+	color[2] = gfxLSIsCollis(x + 4, y - 3);
+	color[3] = gfxLSIsCollis(x + 6, y - 3);
+	color[4] = gfxLSIsCollis(x + 9, y - 3);
+	color[5] = gfxLSIsCollis(x + 11, y - 3);
+	color[6] = gfxLSIsCollis(x + 11, y - 3);
+
+	color[7] = gfxLSIsCollis(x + 3, y - 4);
+	color[8] = gfxLSIsCollis(x + 3, y - 4);
+	color[9] = gfxLSIsCollis(x + 4, y - 4);
+	color[10] = gfxLSIsCollis( x + 6, y - 4);
+	color[11] = gfxLSIsCollis( x + 9, y - 4);
+	color[12] = gfxLSIsCollis( x + 11, y - 4);
+	color[13] = gfxLSIsCollis( x + 11, y - 4);
 
 	collisDir |= LS_COLLIS_UP;
 	break;
     case LS_SCROLL_DOWN:
-	color[0] = gfxLSReadPixel(x + 3, y + 13);
-	color[1] = gfxLSReadPixel(x + 3, y + 13);
-	color[2] = gfxLSReadPixel(x + 4, y + 13);
-	color[3] = gfxLSReadPixel(x + 6, y + 13);
-	color[4] = gfxLSReadPixel(x + 9, y + 13);
-	color[5] = gfxLSReadPixel(x + 11, y + 13);
-	color[6] = gfxLSReadPixel(x + 11, y + 13);
-
-	color[7] = gfxLSReadPixel(x + 3, y + 14);
-	color[8] = gfxLSReadPixel(x + 3, y + 14);
-	color[9] = gfxLSReadPixel(x + 4, y + 14);
-	color[10] = gfxLSReadPixel(x + 6, y + 14);
-	color[11] = gfxLSReadPixel(x + 9, y + 14);
-	color[12] = gfxLSReadPixel(x + 11, y + 14);
-	color[13] = gfxLSReadPixel(x + 11, y + 14);
+	color[0] = gfxLSIsCollis(x + 3, y + 13);
+	color[1] = gfxLSIsCollis(x + 3, y + 13);
+	color[2] = gfxLSIsCollis(x + 4, y + 13);
+	color[3] = gfxLSIsCollis(x + 6, y + 13);
+	color[4] = gfxLSIsCollis(x + 9, y + 13);
+	color[5] = gfxLSIsCollis(x + 11, y + 13);
+	color[6] = gfxLSIsCollis(x + 11, y + 13);
+
+	color[7] = gfxLSIsCollis(x + 3, y + 14);
+	color[8] = gfxLSIsCollis(x + 3, y + 14);
+	color[9] = gfxLSIsCollis(x + 4, y + 14);
+	color[10] = gfxLSIsCollis(x + 6, y + 14);
+	color[11] = gfxLSIsCollis(x + 9, y + 14);
+	color[12] = gfxLSIsCollis(x + 11, y + 14);
+	color[13] = gfxLSIsCollis(x + 11, y + 14);
 
 	collisDir |= LS_COLLIS_DOWN;
 	break;
@@ -337,16 +338,6 @@ ubyte lsIsCollision(S32 x, S32 y, ubyte direction)
 	break;
     }
 
-    /* from now on color[i] contains a non-zero value when there is a collision */
-    for (i = 0; i < 14; i++) {
-	if ((color[i] != LS_COLLIS_COLOR_0) && (color[i] != LS_COLLIS_COLOR_1)
-	    && (color[i] != LS_COLLIS_COLOR_2)
-	    && (color[i] != LS_COLLIS_COLOR_3))
-	    color[i] = 0;
-	else
-	    color[i] = 1;
-    }
-
     for (i = 0; i < 14; i++)
 	if (color[i])
 	    collis = collisDir;
@@ -7,13 +7,20 @@
  ****************************************************************************/
 
 #include "gfx/gfx.h"
+#include "gfx/gfxnch4.h"
 
 #include "living/living.h"
 
 #define	BOB_USED			1
 #define	BOB_VISIBLE		2
 #define	BOB_UPDATED		4
+#define	BOB_DRAWN		8
 
+/*
+ * Every bob remembers where on the landscape it was drawn last (drawn*,
+ * valid while BOB_DRAWN is set), so that showing, moving or hiding it
+ * only has to refresh the old and the new position.
+ */
 struct Bob {
     uword w, h;
     uword xsrc, ysrc;
@@ -21,27 +28,45 @@ struct Bob {
 
     uword sx, sy;
 
+    uword drawnX, drawnY;
+    uword drawnW, drawnH;
+
     int flags;
 };
 
 #define	BOB_MAX		256
 
+/* collection that holds the frames of all bobs */
+#define	BOB_COLL	137
+
 struct Bob list[BOB_MAX];
 
 struct Bob bob_zero;
 
 MemRastPort BobRP;
 
-void gfxNCH4Refresh(void);
+/* opaque runs of the bob frames in BobRPInMem */
+static Spans BobSpans;
 
+/*
+ * The bob frames stay resident in BobRPInMem and all bobs are blitted
+ * straight from there. The buffer is only filled again when it no
+ * longer holds the bob collection.
+ */
 void BobInitLists(void)
 {
-    static bool init;
-
-    if (!init) {
-        gfxCollToMem(137, &BobRPInMem);
-	init = true;
+    if (BobRPInMem.collId != BOB_COLL) {
+        gfxCollToMem(BOB_COLL, &BobRPInMem);
+        gfxDoneSpans(&BobSpans);
     }
+
+    if (!BobSpans.rows)
+        gfxInitSpans(&BobSpans, &BobRPInMem);
+}
+
+void BobDoneLists(void)
+{
+    gfxDoneSpans(&BobSpans);
 }
 
 static struct Bob *GetNthBob(uword BobID)
@@ -77,6 +102,10 @@ void BobDone(uword BobID)
     if (!bob)
         return;
 
+    /* the view may already be gone, so just leave it to the next refresh */
+    if (bob->flags & BOB_DRAWN)
+        gfxLSMarkDirty(bob->drawnX, bob->drawnY, bob->drawnW, bob->drawnH);
+
     bob->flags = 0;
 }
 
@@ -97,6 +126,67 @@ ubyte BobSet(uword BobID, uword xdst, uword ydst, uword xsrc, uword ysrc)
 
 extern int ScrX, ScrY;
 
+static void BobSetDrawn(struct Bob *bob, int x0, int y0, int x1, int y1)
+{
+    bob->drawnX = x0;
+    bob->drawnY = y0;
+    bob->drawnW = x1 - x0;
+    bob->drawnH = y1 - y0;
+
+    bob->flags |= BOB_DRAWN;
+}
+
+/* grows the drawn area of a bob by its current position */
+static void BobAddDrawn(struct Bob *bob)
+{
+    if (bob->flags & BOB_DRAWN) {
+        BobSetDrawn(bob, min(bob->drawnX, bob->xdst),
+                    min(bob->drawnY, bob->ydst),
+                    max(bob->drawnX + bob->drawnW, bob->xdst + bob->w),
+                    max(bob->drawnY + bob->drawnH, bob->ydst + bob->h));
+    } else
+        BobSetDrawn(bob, bob->xdst, bob->ydst,
+                    bob->xdst + bob->w, bob->ydst + bob->h);
+}
+
+/*
+ * refreshes the area a bob was drawn to and the one it is drawn to now,
+ * both at once when they overlap (the usual case for a moving bob)
+ */
+static void BobRefresh(struct Bob *bob)
+{
+    int x0 = bob->xdst, y0 = bob->ydst;
+    int x1 = x0 + bob->w, y1 = y0 + bob->h;
+
+    if (bob->flags & BOB_DRAWN) {
+        int dx0 = bob->drawnX, dy0 = bob->drawnY;
+        int dx1 = dx0 + bob->drawnW, dy1 = dy0 + bob->drawnH;
+
+        if (!(bob->flags & BOB_VISIBLE)) {
+            x0 = dx0;
+            y0 = dy0;
+            x1 = dx1;
+            y1 = dy1;
+        } else if (dx0 < x1 && x0 < dx1 && dy0 < y1 && y0 < dy1) {
+            x0 = min(x0, dx0);
+            y0 = min(y0, dy0);
+            x1 = max(x1, dx1);
+            y1 = max(y1, dy1);
+        } else
+            gfxNCH4RefreshArea(dx0, dy0, dx1 - dx0, dy1 - dy0);
+    } else if (!(bob->flags & BOB_VISIBLE))
+        return;
+
+    gfxNCH4RefreshArea(x0, y0, x1 - x0, y1 - y0);
+
+    /* the old position has been restored completely */
+    if (bob->flags & BOB_VISIBLE)
+        BobSetDrawn(bob, bob->xdst, bob->ydst,
+                    bob->xdst + bob->w, bob->ydst + bob->h);
+    else
+        bob->flags &= ~BOB_DRAWN;
+}
+
 void BobVis(uword BobID)
 {
     struct Bob *bob = GetNthBob(BobID);
@@ -106,7 +196,7 @@ void BobVis(uword BobID)
 
     bob->flags |= BOB_VISIBLE;
 
-    gfxNCH4Refresh();
+    BobRefresh(bob);
 }
 
 void BobInVis(uword BobID)
@@ -118,7 +208,7 @@ void BobInVis(uword BobID)
 
     bob->flags &= ~BOB_VISIBLE;
 
-    gfxNCH4Refresh();
+    BobRefresh(bob);
 }
 
 void BobSetDarkness(ubyte darkness)
@@ -129,14 +219,43 @@ void BobDisplayLists(GC *gc)
 {
     word i;
 
-    gfxPrepareColl(137);
+    /* the whole view is drawn again, where the bobs were does not matter */
+    for (i = 0; i < BOB_MAX; i++)
+        list[i].flags &= ~BOB_DRAWN;
+
+    BobDisplayArea(gc, ScrX, ScrY, GFX_NCH4_VIEW_WIDTH, GFX_NCH4_VIEW_HEIGHT);
+}
+
+/* draws the parts of all visible bobs that lie inside an area of the view */
+void BobDisplayArea(GC *gc, int x, int y, int w, int h)
+{
+    word i;
 
     for (i = 0; i < BOB_MAX; i++) {
 	struct Bob *bob = &list[i];
-
-	if ((bob->flags & BOB_VISIBLE)) {
-            gfxBlit(gc, &BobRPInMem, bob->xsrc, bob->ysrc,
-                    bob->xdst-ScrX, bob->ydst-ScrY, bob->w, bob->h, true);
-	}
+        int x0, y0, x1, y1;
+
+	if (!(bob->flags & BOB_VISIBLE))
+            continue;
+
+        x0 = max(x, bob->xdst);
+        y0 = max(y, bob->ydst);
+        x1 = min(x + w, bob->xdst + bob->w);
+        y1 = min(y + h, bob->ydst + bob->h);
+
+        if (x0 >= x1 || y0 >= y1)
+            continue;
+
+        if (BobSpans.rows)
+            gfxBlitSpans(gc, &BobRPInMem, &BobSpans,
+                         bob->xsrc + (x0 - bob->xdst), bob->ysrc + (y0 - bob->ydst),
+                         x0 - ScrX, y0 - ScrY, x1 - x0, y1 - y0);
+        else
+            gfxBlit(gc, &BobRPInMem,
+                    bob->xsrc + (x0 - bob->xdst), bob->ysrc + (y0 - bob->ydst),
+                    x0 - ScrX, y0 - ScrY, x1 - x0, y1 - y0, true);
+
+        /* a bob that was moved but not shown yet may now be in two places */
+        BobAddDrawn(bob);
     }
 }
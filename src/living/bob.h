@@ -14,6 +14,7 @@
 struct RastPort;
 
 void BobInitLists(void);
+void BobDoneLists(void);
 
 uword BobInit(uword width, uword height);
 void BobDone(uword BobID);
@@ -25,5 +26,6 @@ void BobInVis(uword BobID);
 
 void BobSetDarkness(ubyte darkness);
 void BobDisplayLists(GC *gc);
+void BobDisplayArea(GC *gc, int x, int y, int w, int h);
 
 #endif
@@ -65,6 +65,16 @@ void livDone(void)
 	    gSpriteControl->p_Livings = NULL;
 	}
 
+	if (gSpriteControl->p_Store)
+	    livDoneStore();
+
+	if (gSpriteControl->p_Handles) {
+	    TCFreeMem(gSpriteControl->p_Handles,
+		      gSpriteControl->us_HandleCount * sizeof(struct Living *));
+	    gSpriteControl->p_Handles = NULL;
+	    gSpriteControl->us_HandleCount = 0;
+	}
+
 	if (gSpriteControl->p_Template) {
 	    NODE *node;
 
@@ -90,10 +100,13 @@ void livSetActivAreaId(U32 areaId)
 
 void livLivesInArea(char *uch_Name, U32 areaId)
 {
-    struct Living *liv = livGet(uch_Name);
+    livHLivesInArea(livGetHandle(uch_Name), areaId);
+}
 
-    if (liv)
-	liv->ul_LivesInAreaId = areaId;
+void livHLivesInArea(uword us_Handle, U32 areaId)
+{
+    if (livIsHandle(us_Handle))
+	gSpriteControl->p_Store->p_LivesInAreaId[us_Handle] = areaId;
 }
 
 void livRefreshAll(void)
@@ -103,12 +116,11 @@ void livRefreshAll(void)
 
 void livSetAllInvisible(void)
 {
-    struct Living *liv;
+    uword i;
 
     if (gSpriteControl) {
-	for (liv = (struct Living *) LIST_HEAD(gSpriteControl->p_Livings); NODE_SUCC(liv);
-	     liv = (struct Living *) NODE_SUCC(liv))
-	    livHide(liv);
+	for (i = 0; i < gSpriteControl->us_HandleCount; i++)
+	    livHide(gSpriteControl->p_Handles[i]);
     }
 }
 
@@ -131,72 +143,91 @@ void livSetPlayMode(U32 playMode)
 
 U32 livWhereIs(char *uch_Name)
 {
-    struct Living *liv = livGet(uch_Name);
+    return livHWhereIs(livGetHandle(uch_Name));
+}
+
+U32 livHWhereIs(uword us_Handle)
+{
     U32 loc = 0;
 
-    if (liv)
-	loc = liv->ul_LivesInAreaId;
+    if (livIsHandle(us_Handle))
+	loc = gSpriteControl->p_Store->p_LivesInAreaId[us_Handle];
 
     return loc;
 }
 
 void livSetPos(char *uch_Name, uword XPos, uword YPos)
 {
-    struct Living *liv = livGet(uch_Name);
+    livHSetPos(livGetHandle(uch_Name), XPos, YPos);
+}
 
-    if (liv) {
-	liv->us_XPos = XPos;
-	liv->us_YPos = YPos;
+void livHSetPos(uword us_Handle, uword XPos, uword YPos)
+{
+    if (livIsHandle(us_Handle)) {
+	gSpriteControl->p_Store->p_XPos[us_Handle] = XPos;
+	gSpriteControl->p_Store->p_YPos[us_Handle] = YPos;
     }
 }
 
 void livAnimate(char *uch_Name, ubyte uch_Action, word s_XSpeed, word s_YSpeed)
 {
-    struct Living *liv = livGet(uch_Name);
+    livHAnimate(livGetHandle(uch_Name), uch_Action, s_XSpeed, s_YSpeed);
+}
 
-    if (liv) {
-	liv->uch_Status = LIV_ENABLED;
+void livHAnimate(uword us_Handle, ubyte uch_Action, word s_XSpeed, word s_YSpeed)
+{
+    if (livIsHandle(us_Handle))
+	livAnimateLiving(us_Handle, uch_Action, s_XSpeed, s_YSpeed);
+}
 
-	liv->uch_OldAction = liv->uch_Action;
+static void livAnimateLiving(uword us_Handle, ubyte uch_Action,
+			     word s_XSpeed, word s_YSpeed)
+{
+    struct LivingStore *st = gSpriteControl->p_Store;
 
-	liv->uch_Action = uch_Action;
-	liv->s_XSpeed = s_XSpeed;
-	liv->s_YSpeed = s_YSpeed;
+    st->p_Status[us_Handle] = LIV_ENABLED;
 
-	if (((ubyte) liv->ch_CurrFrameNr == gSpriteControl->uch_LastFrame))
-	    liv->ch_CurrFrameNr = (char) gSpriteControl->uch_FirstFrame;
-    }
+    st->p_OldAction[us_Handle] = st->p_Action[us_Handle];
+
+    st->p_Action[us_Handle] = uch_Action;
+    st->p_XSpeed[us_Handle] = s_XSpeed;
+    st->p_YSpeed[us_Handle] = s_YSpeed;
+
+    if (((ubyte) st->p_CurrFrameNr[us_Handle] == gSpriteControl->uch_LastFrame))
+	st->p_CurrFrameNr[us_Handle] = (char) gSpriteControl->uch_FirstFrame;
 }
 
 void livTurn(char *puch_Name, ubyte uch_Status)
 {
-    struct Living *liv = livGet(puch_Name);
+    livHTurn(livGetHandle(puch_Name), uch_Status);
+}
 
-    if (liv)
-	liv->uch_Status = uch_Status;	/* enable or disable */
+void livHTurn(uword us_Handle, ubyte uch_Status)
+{
+    if (livIsHandle(us_Handle))
+	gSpriteControl->p_Store->p_Status[us_Handle] = uch_Status;	/* enable or disable */
 }
 
 void livStopAll(void)
 {
-    struct Living *liv;
+    uword i;
 
-    for (liv = (struct Living *) LIST_HEAD(gSpriteControl->p_Livings);
-	 NODE_SUCC(liv); liv = (struct Living *) NODE_SUCC(liv)) {
-	if (liv->uch_Status == LIV_ENABLED)
-	    livAnimate(NODE_NAME(liv), ANM_STAND, 0, 0);
+    for (i = 0; i < gSpriteControl->us_HandleCount; i++) {
+	if (gSpriteControl->p_Store->p_Status[i] == LIV_ENABLED)
+	    livAnimateLiving(i, ANM_STAND, 0, 0);
     }
 }
 
 static void livCorrectViewDirection(struct Living *liv)
 {
-    char *name = NODE_NAME(liv->p_OriginTemplate);
+    struct LivingStore *st = gSpriteControl->p_Store;
+    uword i = liv->us_Handle;
 
-    if (liv->uch_Action <= ANM_MOVE_LEFT)
-	liv->uch_ViewDirection = liv->uch_Action;
+    if (st->p_Action[i] <= ANM_MOVE_LEFT)
+	st->p_ViewDirection[i] = st->p_Action[i];
     else {
-	if (!strcmp(name, LIV_TEMPL_BULLE_NAME)
-	    && (liv->uch_Action == ANM_WORK_CONTROL))
-	    liv->uch_ViewDirection = ANM_MOVE_DOWN;
+	if (liv->uch_IsBulle && (st->p_Action[i] == ANM_WORK_CONTROL))
+	    st->p_ViewDirection[i] = ANM_MOVE_DOWN;
     }
 }
 
@@ -206,18 +237,21 @@ void livPrepareAnims(void)
 
 void livDoAnims(ubyte uch_Play, ubyte uch_Move)
 {
-    struct Living *liv;
+    struct LivingStore *st = gSpriteControl->p_Store;
+    uword i;
 
     livPrepareAnims();
 
     lsDoScroll();
 
-    for (liv = (struct Living *) LIST_HEAD(gSpriteControl->p_Livings);
-	 NODE_SUCC(liv); liv = (struct Living *) NODE_SUCC(liv)) {
-	if (liv->uch_Status == LIV_ENABLED) {
+    /* first move and animate all livings and find the frames of their bobs ... */
+    for (i = 0; i < gSpriteControl->us_HandleCount; i++) {
+	if (st->p_Status[i] == LIV_ENABLED) {
+	    struct Living *liv = gSpriteControl->p_Handles[i];
+
 	    if (uch_Move) {
-		liv->us_XPos += liv->s_XSpeed;
-		liv->us_YPos += liv->s_YSpeed;
+		st->p_XPos[i] += st->p_XSpeed[i];
+		st->p_YPos[i] += st->p_YSpeed[i];
 	    }
 
 	    /*
@@ -231,18 +265,27 @@ void livDoAnims(ubyte uch_Play, ubyte uch_Move)
 
 	    livCorrectViewDirection(liv);
 
-	    if (livIsVisible(liv)) {
-		livShow(liv);
+	    if ((st->p_Visible[i] = livIsVisible(liv))) {
+		livCalcFrame(liv);
 
 		/* Action != ANM_STAND -> shitty exception because Marx
                    didn't provide a standing anim */
-		if ((uch_Play) && (liv->uch_Action != ANM_STAND))
-		    liv->ch_CurrFrameNr += (char) gSpriteControl->ch_PlayDirection;
+		if ((uch_Play) && (st->p_Action[i] != ANM_STAND))
+		    st->p_CurrFrameNr[i] += (char) gSpriteControl->ch_PlayDirection;
+
+		if ((ubyte) st->p_CurrFrameNr[i] == gSpriteControl->uch_LastFrame)
+		    livAnimateLiving(i, ANM_STAND, 0, 0);
+	    }
+	}
+    }
 
-		if ((ubyte) liv->ch_CurrFrameNr == gSpriteControl->uch_LastFrame)
-		    livAnimate(NODE_NAME(liv), ANM_STAND, 0, 0);
-	    } else
-		livHide(liv);
+    /* ... then draw them */
+    for (i = 0; i < gSpriteControl->us_HandleCount; i++) {
+	if (st->p_Status[i] == LIV_ENABLED) {
+	    if (st->p_Visible[i])
+		livShow(gSpriteControl->p_Handles[i]);
+	    else
+		livHide(gSpriteControl->p_Handles[i]);
 	}
     }
 }
@@ -255,30 +298,54 @@ void livSetVisLScape(uword us_VisLScapeX, uword us_VisLScapeY)
 
 uword livGetXPos(char *Name)
 {
-    struct Living *liv = livGet(Name);
+    return livHGetXPos(livGetHandle(Name));
+}
+
+uword livHGetXPos(uword us_Handle)
+{
+    if (!livIsHandle(us_Handle))
+	return 0;
 
-    return (liv->us_XPos);
+    return (gSpriteControl->p_Store->p_XPos[us_Handle]);
 }
 
 uword livGetYPos(char *Name)
 {
-    struct Living *liv = livGet(Name);
+    return livHGetYPos(livGetHandle(Name));
+}
+
+uword livHGetYPos(uword us_Handle)
+{
+    if (!livIsHandle(us_Handle))
+	return 0;
 
-    return (liv->us_YPos);
+    return (gSpriteControl->p_Store->p_YPos[us_Handle]);
 }
 
 ubyte livGetViewDirection(char *uch_Name)
 {
-    struct Living *liv = livGet(uch_Name);
+    return livHGetViewDirection(livGetHandle(uch_Name));
+}
+
+ubyte livHGetViewDirection(uword us_Handle)
+{
+    if (!livIsHandle(us_Handle))
+	return 0;
 
-    return (liv->uch_ViewDirection);
+    return (gSpriteControl->p_Store->p_ViewDirection[us_Handle]);
 }
 
 ubyte livGetOldAction(char *uch_Name)
 {
-    struct Living *liv = livGet(uch_Name);
+    return livHGetOldAction(livGetHandle(uch_Name));
+}
 
-    return (liv->uch_OldAction);
+ubyte livHGetOldAction(uword us_Handle)
+{
+    if (!livIsHandle(us_Handle))
+	return 0;
+
+    return (gSpriteControl->p_Store->p_OldAction[us_Handle]);
 }
 
 ubyte livIsPositionInViewDirection(uword us_GXPos, uword us_GYPos,
@@ -314,12 +381,16 @@ ubyte livIsPositionInViewDirection(uword us_GXPos, uword us_GYPos,
 
 ubyte livCanWalk(char *puch_Name)
 {
-    struct Living *liv = livGet(puch_Name);
+    return livHCanWalk(livGetHandle(puch_Name));
+}
 
-    if (liv) {
+ubyte livHCanWalk(uword us_Handle)
+{
+    if (livIsHandle(us_Handle)) {
+	struct LivingStore *st = gSpriteControl->p_Store;
 	ubyte direction;
 
-	switch (liv->uch_Action) {
+	switch (st->p_Action[us_Handle]) {
 	case ANM_MOVE_UP:
 	    direction = LS_SCROLL_UP;
 	    break;
@@ -338,8 +409,8 @@ ubyte livCanWalk(char *puch_Name)
 
 	if (!
 	    (lsIsCollision
-	     (liv->us_XPos + liv->s_XSpeed, liv->us_YPos + liv->s_YSpeed,
-	      direction)))
+	     (st->p_XPos[us_Handle] + st->p_XSpeed[us_Handle],
+	      st->p_YPos[us_Handle] + st->p_YSpeed[us_Handle], direction)))
 	    return 1;
     }
 
@@ -358,11 +429,80 @@ static struct Living *livGet(char *uch_Name)
     return (liv);
 }
 
+/* handles number the livings in the order of the livings list */
+uword livGetHandle(char *uch_Name)
+{
+    struct Living *liv = livGet(uch_Name);
+
+    return liv ? liv->us_Handle : LIV_NO_HANDLE;
+}
+
+static bool livIsHandle(uword us_Handle)
+{
+    if (us_Handle < gSpriteControl->us_HandleCount)
+	return true;
+
+    /* livGet already complained about unknown names */
+    if (us_Handle != LIV_NO_HANDLE)
+	ErrorMsg(Internal_Error, ERROR_MODULE_LIVING, 1);
+
+    return false;
+}
+
+/* one block for all arrays of the store, the widest first */
+static void livInitStore(uword count)
+{
+    struct LivingStore *st = TCAllocMem(sizeof(*st), true);
+    U8 *p = TCAllocMem(count * LIV_STORE_SIZE, true);
+
+    st->p_LivesInAreaId = (U32 *) p;
+    p += count * sizeof(U32);
+
+    st->p_XPos = (uword *) p;
+    p += count * sizeof(uword);
+    st->p_YPos = (uword *) p;
+    p += count * sizeof(uword);
+    st->p_XSpeed = (word *) p;
+    p += count * sizeof(word);
+    st->p_YSpeed = (word *) p;
+    p += count * sizeof(word);
+    st->p_SrcX = (uword *) p;
+    p += count * sizeof(uword);
+    st->p_SrcY = (uword *) p;
+    p += count * sizeof(uword);
+
+    st->p_ViewDirection = p;
+    p += count;
+    st->p_Action = p;
+    p += count;
+    st->p_OldAction = p;
+    p += count;
+    st->p_CurrFrameNr = (char *) p;
+    p += count;
+    st->p_Status = p;
+    p += count;
+    st->p_Visible = p;
+
+    gSpriteControl->p_Store = st;
+}
+
+static void livDoneStore(void)
+{
+    struct LivingStore *st = gSpriteControl->p_Store;
+
+    TCFreeMem(st->p_LivesInAreaId, gSpriteControl->us_HandleCount * LIV_STORE_SIZE);
+    TCFreeMem(st, sizeof(*st));
+
+    gSpriteControl->p_Store = NULL;
+}
+
 static void livAdd(char *uch_Name, char *uch_TemplateName, ubyte uch_XSize,
 		   ubyte uch_YSize, word s_XSpeed, word s_YSpeed)
 {
+    struct LivingStore *st = gSpriteControl->p_Store;
     struct Living *liv;
     struct AnimTemplate *tlt;
+    uword i;
 
     liv = (struct Living *)
 	CreateNode(gSpriteControl->p_Livings, sizeof(struct Living), uch_Name);
@@ -373,24 +513,29 @@ static void livAdd(char *uch_Name, char *uch_TemplateName, ubyte uch_XSize,
     tlt = liv->p_OriginTemplate =
 	(struct AnimTemplate *) GetNode(gSpriteControl->p_Template, uch_TemplateName);
 
+    liv->uch_IsBulle = !strcmp(NODE_NAME(tlt), LIV_TEMPL_BULLE_NAME);
+
     liv->us_LivingNr = BobInit(tlt->us_Width, tlt->us_Height);
 
-    liv->uch_OldAction = 0;
-    liv->uch_Action = 0;
+    i = liv->us_Handle = gSpriteControl->us_HandleCount++;
+    gSpriteControl->p_Handles[i] = liv;
+
+    st->p_OldAction[i] = 0;
+    st->p_Action[i] = 0;
 
-    liv->uch_ViewDirection = 0;
+    st->p_ViewDirection[i] = 0;
 
-    liv->ch_CurrFrameNr = 0;
+    st->p_CurrFrameNr[i] = 0;
 
-    liv->s_XSpeed = s_XSpeed;
-    liv->s_YSpeed = s_YSpeed;
+    st->p_XSpeed[i] = s_XSpeed;
+    st->p_YSpeed[i] = s_YSpeed;
 
-    liv->us_XPos = 0;
-    liv->us_YPos = 0;
+    st->p_XPos[i] = 0;
+    st->p_YPos[i] = 0;
 
-    liv->ul_LivesInAreaId = gSpriteControl->ul_ActivAreaId;
+    st->p_LivesInAreaId[i] = gSpriteControl->ul_ActivAreaId;
 
-    liv->uch_Status = LIV_DISABLED;
+    st->p_Status[i] = LIV_DISABLED;
 }
 
 static void livRem(struct Living *liv)
@@ -444,6 +589,11 @@ static void livLoadLivings(void)
     if (!(cnt = ReadList(l, 0L, pathname)))
 	ErrorMsg(Disk_Defect, ERROR_MODULE_LIVING, 2);
 
+    gSpriteControl->p_Handles = TCAllocMem(cnt * sizeof(struct Living *), true);
+    gSpriteControl->us_HandleCount = 0;
+
+    livInitStore(cnt);
+
     for (i = 0; i < cnt; i++) {
 	char name[TXT_KEY_LENGTH], template[TXT_KEY_LENGTH];
 
@@ -468,43 +618,51 @@ static void livHide(struct Living *liv)
     BobInVis(liv->us_LivingNr);
 }
 
-static void livShow(struct Living *liv)
+/* the frame of the bob of a living, livShow shows it */
+static void livCalcFrame(struct Living *liv)
 {
-    uword frameNr, action;
-    uword srcX, srcY, offset;
+    struct LivingStore *st = gSpriteControl->p_Store;
     struct AnimTemplate *tlt = liv->p_OriginTemplate;
+    uword frameNr, action, offset, i = liv->us_Handle;
 
     /* shitty exception because Marx didn't provide a standing anim */
-    if (liv->uch_Action == ANM_STAND) {
-	action = liv->uch_ViewDirection;
-	liv->ch_CurrFrameNr = 4;
+    if (st->p_Action[i] == ANM_STAND) {
+	action = st->p_ViewDirection[i];
+	st->p_CurrFrameNr[i] = 4;
     } else
-	action = liv->uch_Action;
+	action = st->p_Action[i];
 
-    frameNr = action * gSpriteControl->uch_FrameCount + liv->ch_CurrFrameNr;
+    frameNr = action * gSpriteControl->uch_FrameCount + st->p_CurrFrameNr[i];
 
     frameNr = frameNr + tlt->us_FrameOffsetNr;
 
     offset = frameNr * tlt->us_Width;
 
-    srcY = (offset / LIV_COLL_WIDTH) * tlt->us_Height;
-    srcX = (offset % LIV_COLL_WIDTH);
+    st->p_SrcY[i] = (offset / LIV_COLL_WIDTH) * tlt->us_Height;
+    st->p_SrcX[i] = (offset % LIV_COLL_WIDTH);
+}
+
+static void livShow(struct Living *liv)
+{
+    struct LivingStore *st = gSpriteControl->p_Store;
+    uword i = liv->us_Handle;
 
-    if (BobSet(liv->us_LivingNr, liv->us_XPos, liv->us_YPos, srcX, srcY))
+    if (BobSet(liv->us_LivingNr, st->p_XPos[i], st->p_YPos[i], st->p_SrcX[i], st->p_SrcY[i]))
 	BobVis(liv->us_LivingNr);
 }
 
 static ubyte livIsVisible(struct Living *liv)
 {
+    struct LivingStore *st = gSpriteControl->p_Store;
     uword left, right, up, down;
     ubyte visible = 0;
 
-    left = liv->us_XPos;
+    left = st->p_XPos[liv->us_Handle];
     right = left + liv->uch_XSize;
-    up = liv->us_YPos;
+    up = st->p_YPos[liv->us_Handle];
     down = up + liv->uch_YSize;
 
-    if (liv->ul_LivesInAreaId == gSpriteControl->ul_ActivAreaId)
+    if (st->p_LivesInAreaId[liv->us_Handle] == gSpriteControl->ul_ActivAreaId)
 	if (right > gSpriteControl->us_VisLScapeX)
 	    if (left < (gSpriteControl->us_VisLScapeX + gSpriteControl->us_VisLScapeWidth))
 		if (down > gSpriteControl->us_VisLScapeY)
@@ -75,6 +75,8 @@
 #define LIV_ENABLED      	1
 #define LIV_DISABLED     	0
 
+#define LIV_NO_HANDLE		((uword) -1)
+
 extern void livInit(uword us_VisLScapeX, uword us_VisLScapeY,
 		    uword us_VisLScapeWidth, uword us_VisLScapeHeight,
 		    uword us_TotalLScapeWidth, uword us_TotalLScapeHeight,
@@ -115,6 +117,24 @@ extern void livStopAll(void);
 
 extern ubyte livGetOldAction(char *uch_Name);
 
+/* the same by handle, a handle stays valid until livDone */
+extern uword livGetHandle(char *uch_Name);
+
+extern void livHSetPos(uword us_Handle, uword XPos, uword YPos);
+extern void livHLivesInArea(uword us_Handle, U32 areaId);
+extern U32 livHWhereIs(uword us_Handle);
+
+extern uword livHGetXPos(uword us_Handle);
+extern uword livHGetYPos(uword us_Handle);
+
+extern ubyte livHCanWalk(uword us_Handle);
+extern ubyte livHGetViewDirection(uword us_Handle);
+extern ubyte livHGetOldAction(uword us_Handle);
+
+extern void livHTurn(uword us_Handle, ubyte uch_Status);
+extern void livHAnimate(uword us_Handle, ubyte uch_Action, word s_XSpeed,
+			word s_YSpeed);
+
 /* uword spotInit(bitmap, uword 1 = 48, 2 = 32, 3 = 16 ); */
 /* uword spotDone */
 /* uword spotSetPos(uword, uword, uword); */
@@ -92,6 +92,8 @@ static struct {
 
     U32 actionTime;
      ubyte(*actionFunc) (U32, U32);
+
+    uword living[PLANING_NR_PERSONS + PLANING_NR_GUARDS];	/* handles of Planing_Name */
 } PD;
 
 
@@ -404,9 +406,9 @@ static void plPlayerAction(void)
 	    }
 
 	    for (j = 0; j < BurglarsNr; j++) {
-		xpos[j] = livGetXPos(Planing_Name[j]);
-		ypos[j] = livGetYPos(Planing_Name[j]);
-		area[j] = livWhereIs(Planing_Name[j]);
+		xpos[j] = livHGetXPos(PD.living[j]);
+		ypos[j] = livHGetYPos(PD.living[j]);
+		area[j] = livHWhereIs(PD.living[j]);
 	    }
 
 
@@ -422,57 +424,55 @@ static void plPlayerAction(void)
 	    if ((i >= BurglarsNr) && PD.guardKO[i - BurglarsNr]) {
 		switch (PD.guardKO[i - BurglarsNr]) {
 		case 1:
-		    livAnimate(Planing_Name[i],
-			       livGetViewDirection(Planing_Name[i]), 0, 0);
+		    livHAnimate(PD.living[i],
+				livHGetViewDirection(PD.living[i]), 0, 0);
 		    break;
 
 		case 2:
-		    livAnimate(Planing_Name[i], ANM_DUSEL_POLICE, 0, 0);
+		    livHAnimate(PD.living[i], ANM_DUSEL_POLICE, 0, 0);
 		    break;
 
 		case 3:
-		    livAnimate(Planing_Name[i], ANM_WORK_CONTROL, 0, 0);
+		    livHAnimate(PD.living[i], ANM_WORK_CONTROL, 0, 0);
 		    break;
 		}
 	    } else if ((PD.action = NextAction(plSys))) {
 		if (!(PD.timer % 12) && (i >= BurglarsNr)
 		    && !(Search.EscapeBits & FAHN_ALARM_GUARD)) {
-		    register ubyte j, dir =
-			livGetViewDirection(Planing_Name[i]);
-		    register uword xpos = livGetXPos(Planing_Name[i]);
-		    register uword ypos = livGetYPos(Planing_Name[i]);
+		    register ubyte dir =
+			livHGetViewDirection(PD.living[i]);
+		    register uword xpos = livHGetXPos(PD.living[i]);
+		    register uword ypos = livHGetYPos(PD.living[i]);
 
 #ifndef PLAN_IS_PERFECT
-		    for (j = 0; j < BurglarsNr; j++) {
-			if (tcGuardDetectsGuy
-			    (Planing_GuardRoomList[i - BurglarsNr], xpos, ypos,
-			     dir, Planing_Name[i], Planing_Name[j])) {
-			    if ((PD.bldId == Building_Starford_Kaserne) && j)
-				break;
-
-			    plSay("PLAYER_GUARD_ALARM_1", i);
-			    inpSetWaitTicks(INP_AS_FAST_AS_POSSIBLE);
-			    Search.DeriTime += PLANING_DERI_ALARM;
-			    Search.EscapeBits |= FAHN_ALARM | FAHN_ALARM_GUARD;
+		    /* the first burglar the guard sees */
+		    S32 j = tcGuardDetectsGuys(Planing_GuardRooms[i - BurglarsNr],
+					       xpos, ypos, dir, PD.living[i],
+					       PD.living, BurglarsNr);
+
+		    if ((j >= 0)
+			&& !((PD.bldId == Building_Starford_Kaserne) && j)) {
+			plSay("PLAYER_GUARD_ALARM_1", i);
+			inpSetWaitTicks(INP_AS_FAST_AS_POSSIBLE);
+			Search.DeriTime += PLANING_DERI_ALARM;
+			Search.EscapeBits |= FAHN_ALARM | FAHN_ALARM_GUARD;
 
-			    PD.guardKO[((Police)
-					dbGetObject(OL_NR
-						    (GetNthNode
-						     (PersonsList,
-						      i))))->LivingID -
-				       BurglarsNr] = 3;
-			    break;
-			}
+			PD.guardKO[((Police)
+				    dbGetObject(OL_NR
+						(GetNthNode
+						 (PersonsList,
+						  i))))->LivingID -
+				   BurglarsNr] = 3;
 		    }
 #endif
 		}
 #ifndef PLAN_IS_PERFECT
 		if (!(PD.timer % 3) && (i < BurglarsNr)
-		    && (livWhereIs(Planing_Name[i]) == lsGetActivAreaID())) {
+		    && (livHWhereIs(PD.living[i]) == lsGetActivAreaID())) {
 		    if (PD.bldId != Building_Starford_Kaserne) {
 			if (!(Search.EscapeBits & FAHN_ALARM_MICRO)
-			    && tcAlarmByMicro(livGetXPos(Planing_Name[i]),
-					      livGetYPos(Planing_Name[i]),
+			    && tcAlarmByMicro(livHGetXPos(PD.living[i]),
+					      livHGetYPos(PD.living[i]),
 					      PD.currLoudness[i])) {
 			    Search.DeriTime += PLANING_DERI_ALARM;
 			    Search.EscapeBits |= FAHN_ALARM | FAHN_ALARM_MICRO;
@@ -486,11 +486,11 @@ static void plPlayerAction(void)
 		if (PD.action->Type != ACTION_GO) {
 		    if (i < BurglarsNr) {
 			if (PD.action->Type == ACTION_SIGNAL)
-			    livAnimate(Planing_Name[i], ANM_MAKE_CALL, 0, 0);
+			    livHAnimate(PD.living[i], ANM_MAKE_CALL, 0, 0);
 			else
 			    plWork(i);
 		    } else
-			livAnimate(Planing_Name[i], ANM_WORK_CONTROL, 0, 0);
+			livHAnimate(PD.living[i], ANM_WORK_CONTROL, 0, 0);
 		}
 
 		switch (PD.action->Type) {
@@ -503,7 +503,7 @@ static void plPlayerAction(void)
 				   ActionData(PD.action,
 					      struct ActionGo *)->Direction);
 
-			    if (livCanWalk(Planing_Name[i])) {
+			    if (livHCanWalk(PD.living[i])) {
 				PD.currLoudness[i] = tcGetWalkLoudness();
 				PD.unableToWork[i] = 0;
 
@@ -522,7 +522,7 @@ static void plPlayerAction(void)
 				    DoScrolling = 1;
 				}
 			    } else {
-				if (livWhereIs(Planing_Name[i]) ==
+				if (livHWhereIs(PD.living[i]) ==
 				    lsGetActivAreaID())
 				    UnableToWork(i, ACTION_GO);
 			    }
@@ -599,7 +599,7 @@ static void plPlayerAction(void)
 			    if (plIsStair
 				(ActionData(PD.action, struct ActionUse *)->
 				 ItemId))
-				 livLivesInArea(Planing_Name[i],
+				 livHLivesInArea(PD.living[i],
 						StairConnectsGet(ActionData
 								 (PD.action,
 								  struct
@@ -932,7 +932,7 @@ static void plPlayerAction(void)
 								(Planing_Name
 								 [i]), &xpos,
 								&ypos);
-					    livSetPos(Planing_Name[i], xpos,
+					    livHSetPos(PD.living[i], xpos,
 						      ypos);
 
 					    livRefreshAll();
@@ -1242,8 +1242,8 @@ static void plPlayerAction(void)
 				    (ActionData
 				     (PD.action,
 				      struct ActionDrop *)->ItemId <= 9708)) {
-				    lsAddLootBag(livGetXPos(Planing_Name[i]),
-						 livGetYPos(Planing_Name[i]),
+				    lsAddLootBag(livHGetXPos(PD.living[i]),
+						 livHGetYPos(PD.living[i]),
 						 ActionData(PD.action,
 							    struct ActionDrop
 							    *)->ItemId - 9700);
@@ -1566,13 +1566,13 @@ static void plPlayerAction(void)
 		}
 	    } else {
 		PD.handlerEnded[i] = 1;
-		livAnimate(Planing_Name[i], ANM_STAND, 0, 0);
+		livHAnimate(PD.living[i], ANM_STAND, 0, 0);
 	    }
 	} else {
 	    PD.currLoudness[i] = PLANING_LOUDNESS_STD;
 
 	    if ((PD.handlerEnded[i] >= 2) && (PD.handlerEnded[i] <= 30)) {
-		livAnimate(Planing_Name[i], ANM_ELEKTRO, 0, 0);
+		livHAnimate(PD.living[i], ANM_ELEKTRO, 0, 0);
 		PD.handlerEnded[i]++;
 	    }
 
@@ -1583,7 +1583,7 @@ static void plPlayerAction(void)
 	    }
 
 	    if (PD.handlerEnded[i] == 32)
-		livAnimate(Planing_Name[i], ANM_DUSEL, 0, 0);
+		livHAnimate(PD.living[i], ANM_DUSEL, 0, 0);
 	}
     }
 
@@ -1645,6 +1645,9 @@ S32 plPlayer(U32 objId, U32 actionTime, ubyte(*actionFunc) (U32, U32))
 		PD.actionTime = actionTime;
 		PD.actionFunc = actionFunc;
 
+		for (i = 0; i < PersonsNr; i++)
+		    PD.living[i] = livGetHandle(Planing_Name[i]);
+
 		/* Init data & search structure */
 		for (i = 0; i < PLANING_NR_PERSONS; i++) {
 		    PD.handlerEnded[i] = 1;
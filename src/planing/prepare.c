@@ -40,7 +40,7 @@ ubyte Planing_Guard[PLANING_NR_GUARDS];
 
 char Planing_Name[PLANING_NR_PERSONS + PLANING_NR_GUARDS][20];
 
-LIST *Planing_GuardRoomList[PLANING_NR_GUARDS];
+struct LSRoomRaster *Planing_GuardRooms[PLANING_NR_GUARDS];
 
 U32 Planing_BldId;
 
@@ -133,7 +133,8 @@ void plPrepareSprite(U32 livNr, U32 areaId)
     else {
 	livAnimate(Planing_Name[livNr], ANM_MOVE_DOWN, 0, 0);
 
-	Planing_GuardRoomList[livNr - BurglarsNr] = lsGetRoomsOfArea(areaId);
+	/* guards of the same area share its raster */
+	Planing_GuardRooms[livNr - BurglarsNr] = lsGetRoomRaster(areaId);
     }
 }
 
@@ -178,8 +179,9 @@ void plUnprepareGfx(void)
 
     gfxClearArea(u_gc);
 
+    /* the rasters belong to the landscape */
     for (i = BurglarsNr; i < PersonsNr; i++)
-	RemoveList(Planing_GuardRoomList[i - BurglarsNr]);
+	Planing_GuardRooms[i - BurglarsNr] = NULL;
 
     lsDoneLandScape();
 
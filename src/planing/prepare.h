@@ -130,7 +130,7 @@ extern ubyte Planing_Guard[PLANING_NR_GUARDS];
 
 extern char Planing_Name[PLANING_NR_PERSONS + PLANING_NR_GUARDS][20];
 
-extern LIST *Planing_GuardRoomList[PLANING_NR_GUARDS];
+extern struct LSRoomRaster *Planing_GuardRooms[PLANING_NR_GUARDS];
 
 extern U32 Planing_BldId;
 
@@ -248,7 +248,7 @@ void plInsertGuard(LIST * list, U32 current, U32 guard)
 {
     switch (livGetViewDirection(Planing_Name[current])) {
     case ANM_MOVE_LEFT:
-	tcInsertGuard(list, Planing_GuardRoomList[guard - BurglarsNr],
+	tcInsertGuard(list, Planing_GuardRooms[guard - BurglarsNr],
 		      livGetXPos(Planing_Name[current]) - 9,
 		      livGetYPos(Planing_Name[current]),
 		      14, 14,
@@ -258,7 +258,7 @@ void plInsertGuard(LIST * list, U32 current, U32 guard)
 	break;
 
     case ANM_MOVE_RIGHT:
-	tcInsertGuard(list, Planing_GuardRoomList[guard - BurglarsNr],
+	tcInsertGuard(list, Planing_GuardRooms[guard - BurglarsNr],
 		      livGetXPos(Planing_Name[current]) + 9,
 		      livGetYPos(Planing_Name[current]),
 		      14, 14,
@@ -268,7 +268,7 @@ void plInsertGuard(LIST * list, U32 current, U32 guard)
 	break;
 
     case ANM_MOVE_UP:
-	tcInsertGuard(list, Planing_GuardRoomList[guard - BurglarsNr],
+	tcInsertGuard(list, Planing_GuardRooms[guard - BurglarsNr],
 		      livGetXPos(Planing_Name[current]),
 		      livGetYPos(Planing_Name[current]) - 9,
 		      14, 14,
@@ -278,7 +278,7 @@ void plInsertGuard(LIST * list, U32 current, U32 guard)
 	break;
 
     case ANM_MOVE_DOWN:
-	tcInsertGuard(list, Planing_GuardRoomList[guard - BurglarsNr],
+	tcInsertGuard(list, Planing_GuardRooms[guard - BurglarsNr],
 		      livGetXPos(Planing_Name[current]),
 		      livGetYPos(Planing_Name[current]) + 9,
 		      14, 14,
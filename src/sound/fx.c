@@ -18,6 +18,8 @@
 #include "sound/fx.h"
 #include "sound/hsc.h"
 
+#include "gfx/gfxprof.h"
+
 #define SND_STREAM_CHUNK_BYTES (SND_SAMPLES * (int)sizeof(S16))
 
 struct FXBase FXBase;
@@ -120,6 +122,7 @@ static int SDLCALL sndAudioThread(void *userdata)
 
         while (FXBase.audioThreadRunning && deficit > 0) {
             int chunk = SDL_min(deficit, SND_STREAM_CHUNK_BYTES);
+            Uint64 start;
 
             chunk &= ~(int) (sizeof(S16) - 1);
             if (chunk <= 0) {
@@ -127,7 +130,9 @@ static int SDLCALL sndAudioThread(void *userdata)
             }
 
             sndAudioLock();
+            start = gfxProfStart();
             MixAudioChunk(MixChunk, chunk);
+            gfxProfStop(GFX_PROF_AUDIO, start);
             sndAudioUnlock();
 
             if (!SDL_PutAudioStreamData(FXBase.audioStream, MixChunk, chunk)) {
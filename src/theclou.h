@@ -29,6 +29,8 @@ typedef uint16_t U16;
 typedef int16_t S16;
 typedef uint32_t U32;
 typedef int32_t S32;
+typedef uint64_t U64;
+typedef int64_t S64;
 
 typedef U8 ubyte;
 typedef S8 byte;
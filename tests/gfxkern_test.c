@@ -0,0 +1,178 @@
+/****************************************************************************
+  Copyright (c) 2005 Vasco Alexandre da Silva Costa
+
+  Please read the license terms contained in the LICENSE and
+  publiclicensecontract.doc files which should be contained with this
+  distribution.
+ ****************************************************************************/
+
+/*
+ * raster operation kernels against the scalar reference
+ *
+ * Every vector kernel the cpu supports is checked for every source and
+ * destination byte pair, and for all widths 0-99 at every source and
+ * destination alignment. The kernels are static, so the module is
+ * included here.
+ */
+
+#include <stdio.h>
+
+#include "gfx/gfxkern.c"
+
+#define TEST_MAX_WIDTH  100
+#define TEST_MAX_ALIGN  32
+#define TEST_GUARD      32
+
+#define TEST_ROW_SIZE   (TEST_MAX_ALIGN + TEST_MAX_WIDTH + TEST_GUARD)
+
+typedef struct {
+    const char *name;
+    GfxRopRowFunc rop[GFX_ROP_COUNT];
+} RopSet;
+
+static const char *RopNames[GFX_ROP_COUNT] = {
+    "BLIT", "MASK_BLIT", "CLR", "SET", "OVERLAY", "OVERLAY_MSK", "LIGHT"
+};
+
+static RopSet Reference;
+
+static U32 TestSeed = 1;
+static U32 TestFailures = 0;
+
+/* mostly small values, so transparent (0) and bright (0x40) pixels are frequent */
+static U8 testRandomByte(void)
+{
+    U32 r;
+
+    TestSeed = TestSeed * 1103515245 + 12345;
+    r = (TestSeed >> 16) & 0x7fff;
+
+    switch (r & 3) {
+    case 0:
+        return 0;
+    case 1:
+        return (U8) ((r >> 2) & 0x40);
+    default:
+        return (U8) (r >> 2);
+    }
+}
+
+static void testSetRops(RopSet *set, const char *name,
+                        GfxRopRowFunc maskBlit, GfxRopRowFunc clr,
+                        GfxRopRowFunc setRop, GfxRopRowFunc overlay,
+                        GfxRopRowFunc light)
+{
+    gfxSetRops(maskBlit, clr, setRop, overlay, light);
+
+    set->name = name;
+    memcpy(set->rop, gfxRopRow, sizeof(set->rop));
+}
+
+static void testFail(const RopSet *set, int op, const char *what,
+                     size_t n, size_t sa, size_t da)
+{
+    if (TestFailures++ < 20) {
+        printf("%s %s: %s (width %u, src align %u, dst align %u)\n",
+               set->name, RopNames[op], what,
+               (unsigned) n, (unsigned) sa, (unsigned) da);
+    }
+}
+
+/* all 256 x 256 source / destination byte pairs */
+static void testBytePairs(const RopSet *set)
+{
+    U8 src[256], ref[256], dst[256];
+    int op, s, d;
+
+    for (op = 0; op < GFX_ROP_COUNT; op++) {
+        for (s = 0; s < 256; s++) {
+            memset(src, s, sizeof(src));
+
+            for (d = 0; d < 256; d++)
+                ref[d] = dst[d] = (U8) d;
+
+            Reference.rop[op](ref, src, sizeof(ref));
+            set->rop[op](dst, src, sizeof(dst));
+
+            if (memcmp(ref, dst, sizeof(dst)) != 0)
+                testFail(set, op, "byte pair mismatch", sizeof(dst), 0, 0);
+        }
+    }
+}
+
+/* every width and alignment, the bytes around the row must stay untouched */
+static void testWidths(const RopSet *set)
+{
+    U8 src[TEST_ROW_SIZE], ref[TEST_ROW_SIZE], dst[TEST_ROW_SIZE];
+    size_t n, sa, da, i;
+    int op;
+
+    for (op = 0; op < GFX_ROP_COUNT; op++) {
+        for (n = 0; n < TEST_MAX_WIDTH; n++) {
+            for (sa = 0; sa < TEST_MAX_ALIGN; sa++) {
+                for (da = 0; da < TEST_MAX_ALIGN; da++) {
+                    for (i = 0; i < TEST_ROW_SIZE; i++) {
+                        src[i] = testRandomByte();
+                        ref[i] = dst[i] = testRandomByte();
+                    }
+
+                    Reference.rop[op](ref + da, src + sa, n);
+                    set->rop[op](dst + da, src + sa, n);
+
+                    if (memcmp(ref, dst, sizeof(dst)) != 0)
+                        testFail(set, op, "row mismatch", n, sa, da);
+                }
+            }
+        }
+    }
+}
+
+static void testSet(const RopSet *set)
+{
+    U32 failures = TestFailures;
+
+    testBytePairs(set);
+    testWidths(set);
+
+    printf("%-8s %s\n", set->name, failures == TestFailures ? "ok" : "FAILED");
+}
+
+int main(int argc, char *argv[])
+{
+    RopSet set;
+
+    (void) argc;
+    (void) argv;
+
+    testSetRops(&Reference, "scalar", gfxRopMaskBlitScalar, gfxRopClrScalar,
+                gfxRopSetScalar, gfxRopOverlayScalar, gfxRopLightScalar);
+
+#ifdef GFX_KERN_X86
+    if (SDL_HasSSE2()) {
+        testSetRops(&set, "sse2", gfxRopMaskBlitSSE2, gfxRopClrSSE2,
+                    gfxRopSetSSE2, gfxRopOverlaySSE2, gfxRopLightSSE2);
+        testSet(&set);
+    }
+
+    if (SDL_HasAVX2()) {
+        testSetRops(&set, "avx2", gfxRopMaskBlitAVX2, gfxRopClrAVX2,
+                    gfxRopSetAVX2, gfxRopOverlayAVX2, gfxRopLightAVX2);
+        testSet(&set);
+    }
+#endif
+
+#ifdef GFX_KERN_NEON
+    testSetRops(&set, "neon", gfxRopMaskBlitNEON, gfxRopClrNEON,
+                gfxRopSetNEON, gfxRopOverlayNEON, gfxRopLightNEON);
+    testSet(&set);
+#endif
+
+    /* and whatever gfxKernInit picks */
+    gfxKernInit();
+
+    set.name = "selected";
+    memcpy(set.rop, gfxRopRow, sizeof(set.rop));
+    testSet(&set);
+
+    return TestFailures ? 1 : 0;
+}
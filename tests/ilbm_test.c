@@ -0,0 +1,336 @@
+/****************************************************************************
+  Copyright (c) 2005 Vasco Alexandre da Silva Costa
+
+  Please read the license terms contained in the LICENSE and
+  publiclicensecontract.doc files which should be contained with this
+  distribution.
+ ****************************************************************************/
+
+/*
+ * ILBM decoder against golden hashes
+ *
+ *   ilbm_test <table> [picture directory]
+ *   ilbm_test --print [files]
+ *
+ * Each line of the table is "<name> <hash>", the hash is FNV-1a over the
+ * decoded pixels (SCREEN_SIZE bytes) followed by the palette. Names of
+ * the form "gen:<n>" are pictures built by this test (raw and ByteRun1,
+ * 1-8 planes, various sizes), all other names are files in the picture
+ * directory and are skipped when no directory is given.
+ *
+ * --print writes table lines for the generated pictures and the given
+ * files. The table was written with the old bit-by-bit decoder.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "gfx/gfxilbm.h"
+#include "gfx/gfxkern.h"
+
+#define TEST_FNV_BASIS      UINT64_C(0xcbf29ce484222325)
+#define TEST_FNV_PRIME      UINT64_C(0x100000001b3)
+
+#define TEST_GEN_COUNT      64
+#define TEST_GEN_PREFIX     "gen:"
+
+/* 8 planes of a whole screen are SCREEN_SIZE bytes, ByteRun1 adds 1 in 128 */
+#define TEST_GEN_MAX_SIZE   (2 * SCREEN_SIZE + 4096)
+
+static U32 TestSeed;
+
+static U8 Pixels[SCREEN_SIZE];
+static U8 Palette[GFX_PALETTE_SIZE];
+
+static U32 testRandom(void)
+{
+    TestSeed = TestSeed * 1103515245 + 12345;
+    return (TestSeed >> 16) & 0x7fff;
+}
+
+static U64 testHash(const U8 *p, size_t size, U64 hash)
+{
+    size_t i;
+
+    for (i = 0; i < size; i++)
+        hash = (hash ^ p[i]) * TEST_FNV_PRIME;
+
+    return hash;
+}
+
+static U8 *testPut_U16BE(U8 *p, U16 x)
+{
+    p[0] = (U8) (x >> 8);
+    p[1] = (U8) x;
+    return p + 2;
+}
+
+static U8 *testPut_U32BE(U8 *p, U32 x)
+{
+    p = testPut_U16BE(p, (U16) (x >> 16));
+    return testPut_U16BE(p, (U16) x);
+}
+
+static U8 *testPutChunk(U8 *p, const char *id, U32 size)
+{
+    memcpy(p, id, 4);
+    return testPut_U32BE(p + 4, size);
+}
+
+/* ByteRun1, runs never cross the end of the row */
+static U8 *testByteRun1(U8 *p, const U8 *row, size_t n)
+{
+    size_t i = 0;
+
+    while (i < n) {
+        size_t run = 1;
+
+        while (i + run < n && run < 128 && row[i + run] == row[i])
+            run++;
+
+        if (run >= 2) {
+            *p++ = (U8) (257 - run);
+            *p++ = row[i];
+            i += run;
+        } else {
+            size_t lit = 1;
+
+            while (i + lit < n && lit < 128
+                   && !(i + lit + 1 < n && row[i + lit] == row[i + lit + 1]))
+                lit++;
+
+            *p++ = (U8) (lit - 1);
+            memcpy(p, row + i, lit);
+            p += lit;
+            i += lit;
+        }
+    }
+
+    return p;
+}
+
+/* builds generated picture nr, returns its size */
+static size_t testGenerate(U32 nr, U8 *lbm)
+{
+    static const U16 widths[] = {
+        1, 7, 8, 9, 15, 16, 17, 31, 33, 63, 64, 100, 160, 255, 319, 320
+    };
+    U8 row[SCREEN_WIDTH / 8 + 2];
+    U16 planes = 1 + nr % 8, w, h, t, s;
+    bool compressed = (nr / 8) % 2;
+    size_t rowBytes, i;
+    U8 *p, *form, *body;
+
+    TestSeed = nr + 1;
+
+    w = widths[testRandom() % (sizeof(widths) / sizeof(widths[0]))];
+    h = 1 + testRandom() % SCREEN_HEIGHT;
+    rowBytes = ((w + 15) & 0xfff0) / 8;
+
+    p = testPutChunk(lbm, "FORM", 0);
+    form = p;
+    memcpy(p, "ILBM", 4);
+    p += 4;
+
+    p = testPutChunk(p, "BMHD", 20);
+    p = testPut_U16BE(p, w);
+    p = testPut_U16BE(p, h);
+    p = testPut_U32BE(p, 0);            /* x, y */
+    *p++ = (U8) planes;
+    *p++ = 0;                           /* masking */
+    *p++ = compressed;
+    *p++ = 0;
+    p = testPut_U16BE(p, 0);            /* transparent color */
+    *p++ = 10;                          /* aspect */
+    *p++ = 11;
+    p = testPut_U16BE(p, SCREEN_WIDTH);
+    p = testPut_U16BE(p, SCREEN_HEIGHT);
+
+    /* a chunk the decoder has to skip */
+    p = testPutChunk(p, "CRNG", 8);
+    memset(p, 0, 8);
+    p += 8;
+
+    p = testPutChunk(p, "CMAP", GFX_PALETTE_SIZE);
+    for (i = 0; i < GFX_PALETTE_SIZE; i++)
+        *p++ = (U8) testRandom();
+
+    p = testPutChunk(p, "BODY", 0);
+    body = p;
+
+    for (t = 0; t < h; t++) {
+        for (s = 0; s < planes; s++) {
+            /* runs of equal bytes are as common as in real pictures */
+            for (i = 0; i < rowBytes; i++) {
+                if (i > 0 && testRandom() % 3 == 0)
+                    row[i] = row[i - 1];
+                else
+                    row[i] = (U8) testRandom();
+            }
+
+            if (compressed)
+                p = testByteRun1(p, row, rowBytes);
+            else {
+                memcpy(p, row, rowBytes);
+                p += rowBytes;
+            }
+        }
+    }
+
+    testPut_U32BE(body - 4, (U32) (p - body));
+    testPut_U32BE(form - 4, (U32) (p - form));
+
+    return p - lbm;
+}
+
+static U64 testDecode(const U8 *lbm)
+{
+    /* the decoder has to clear what it does not write */
+    memset(Pixels, 0xa5, sizeof(Pixels));
+
+    gfxSetCMAP(lbm, Palette);
+    gfxILBMToRAW(lbm, Pixels, SCREEN_SIZE);
+
+    return testHash(Palette, sizeof(Palette),
+                    testHash(Pixels, sizeof(Pixels), TEST_FNV_BASIS));
+}
+
+static U8 *testLoad(const char *fileName)
+{
+    FILE *fp;
+    U8 *lbm = NULL;
+    long size;
+
+    if (!(fp = fopen(fileName, "rb")))
+        return NULL;
+
+    if (fseek(fp, 0, SEEK_END) == 0 && (size = ftell(fp)) > 0
+        && fseek(fp, 0, SEEK_SET) == 0) {
+        lbm = malloc(size);
+
+        if (lbm && fread(lbm, 1, size, fp) != (size_t) size) {
+            free(lbm);
+            lbm = NULL;
+        }
+    }
+
+    fclose(fp);
+    return lbm;
+}
+
+/* the hash of a table entry, false if the picture is not there */
+static bool testHashOf(const char *name, const char *dir, U8 *gen, U64 *hash)
+{
+    char pathname[2 * 1024 + 2];
+    U8 *lbm;
+
+    if (strncmp(name, TEST_GEN_PREFIX, strlen(TEST_GEN_PREFIX)) == 0) {
+        testGenerate((U32) atoi(name + strlen(TEST_GEN_PREFIX)), gen);
+        *hash = testDecode(gen);
+        return true;
+    }
+
+    if (!dir)
+        return false;
+
+    snprintf(pathname, sizeof(pathname), "%s/%s", dir, name);
+
+    if (!(lbm = testLoad(pathname)))
+        return false;
+
+    *hash = testDecode(lbm);
+    free(lbm);
+    return true;
+}
+
+static int testPrint(int argc, char *argv[], U8 *gen)
+{
+    int i;
+
+    for (i = 0; i < TEST_GEN_COUNT; i++) {
+        testGenerate(i, gen);
+        printf(TEST_GEN_PREFIX "%d %016llx\n", i,
+               (unsigned long long) testDecode(gen));
+    }
+
+    for (i = 0; i < argc; i++) {
+        U8 *lbm = testLoad(argv[i]);
+        const char *name = strrchr(argv[i], '/');
+
+        if (!lbm) {
+            fprintf(stderr, "cannot read %s\n", argv[i]);
+            return 1;
+        }
+
+        printf("%s %016llx\n", name ? name + 1 : argv[i],
+               (unsigned long long) testDecode(lbm));
+        free(lbm);
+    }
+
+    return 0;
+}
+
+static int testCompare(const char *table, const char *dir, U8 *gen)
+{
+    char line[1024], name[1024];
+    unsigned long long golden;
+    U32 checked = 0, skipped = 0, failures = 0;
+    FILE *fp;
+
+    if (!(fp = fopen(table, "r"))) {
+        fprintf(stderr, "cannot read %s\n", table);
+        return 1;
+    }
+
+    while (fgets(line, sizeof(line), fp)) {
+        U64 hash;
+
+        if (line[0] == '#' || sscanf(line, "%1023s %llx", name, &golden) != 2)
+            continue;
+
+        if (!testHashOf(name, dir, gen, &hash)) {
+            skipped++;
+            continue;
+        }
+
+        checked++;
+
+        if (hash != golden) {
+            printf("%s: %016llx, expected %016llx\n", name,
+                   (unsigned long long) hash, golden);
+            failures++;
+        }
+    }
+
+    fclose(fp);
+
+    printf("%u pictures checked, %u skipped, %u failed\n",
+           checked, skipped, failures);
+
+    return (failures || !checked) ? 1 : 0;
+}
+
+int main(int argc, char *argv[])
+{
+    U8 *gen;
+    int rc;
+
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s <table> [picture directory]\n"
+                "       %s --print [files]\n", argv[0], argv[0]);
+        return 2;
+    }
+
+    gfxKernInit();
+
+    if (!(gen = malloc(TEST_GEN_MAX_SIZE)))
+        return 1;
+
+    if (strcmp(argv[1], "--print") == 0)
+        rc = testPrint(argc - 2, argv + 2, gen);
+    else
+        rc = testCompare(argv[1], argc > 2 ? argv[2] : NULL, gen);
+
+    free(gen);
+    return rc;
+}